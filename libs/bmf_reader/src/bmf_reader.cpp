@@ -1,6 +1,8 @@
 #include "bmf_reader/bmf_reader.h"
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <optional>
 
 constexpr size_t BMF_HEADER_BYTE_SIZE = 4;
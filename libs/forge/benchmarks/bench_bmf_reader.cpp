@@ -0,0 +1,55 @@
+#include <bmf_reader/bmf_reader.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+  /// Appends a block with the given type and `size` zeroed content bytes.
+  void append_block(
+      std::vector<unsigned char>& file,
+      int8_t type,
+      int32_t size) {
+    file.push_back(static_cast<unsigned char>(type));
+
+    const auto size_offset = file.size();
+    file.resize(size_offset + sizeof(size) + size);
+    std::memcpy(file.data() + size_offset, &size, sizeof(size));
+  }
+
+  /// Builds a synthetic binary BMFont file describing `char_count` glyphs,
+  /// laid out like the files written by AngelCode's BMFont tool.
+  std::vector<unsigned char> make_bmfont(int32_t char_count) {
+    constexpr int32_t kCharByteSize = 20;
+    std::vector<unsigned char> file = {'B', 'M', 'F', 3};
+
+    append_block(file, 1, 1);                          // info
+    append_block(file, 2, 15);                         // common
+    append_block(file, 3, 16);                         // pages
+    append_block(file, 4, char_count * kCharByteSize); // chars
+
+    // The reader requires every block to end before the end of the file.
+    file.push_back(0);
+
+    return file;
+  }
+} // namespace
+
+static void BM_ReadBmfont(benchmark::State& state) {
+  const auto file = make_bmfont(static_cast<int32_t>(state.range(0)));
+
+  for (auto _ : state) {
+    const auto result = read_bmfont(file);
+
+    if (result != BmfReadResult::Ok) {
+      state.SkipWithError("read_bmfont failed");
+      break;
+    }
+
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK(BM_ReadBmfont)->Arg(96)->Arg(4096);
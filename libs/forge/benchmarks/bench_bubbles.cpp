@@ -0,0 +1,158 @@
+#include <forge/job_system.h>
+#include <forge/particle_store.h>
+#include <forge/spatial_grid.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Match the bubble game's simulation settings. The play field grows with the
+// entity count so the density of bubbles per grid cell stays the same.
+constexpr float kBubbleSize = 64.0f;
+constexpr float kGridCellSize = 128.0f;
+constexpr float kUpdateDeltaS = 1.0f / 60.0f;
+constexpr float kBubblesPerPixel = 64.0f / (352.0f * 430.0f);
+
+namespace {
+  /// Edge length of a square play field holding `count` bubbles at the game's
+  /// usual density.
+  float field_size_for(size_t count) {
+    return std::sqrt(static_cast<float>(count) / kBubblesPerPixel);
+  }
+
+  /// Fills `store` with `count` randomly placed bubbles.
+  void spawn_bubbles(ParticleStore& store, size_t count) {
+    const auto field_size = field_size_for(count);
+    std::default_random_engine engine(1234);
+    std::uniform_real_distribution<float> position(0.0f, field_size);
+    std::uniform_real_distribution<float> speed(90.0f, 150.0f);
+    std::uniform_real_distribution<float> amplitude(0.05f, 1.0f);
+    std::uniform_real_distribution<float> frequency(0.2f, 2.0f);
+
+    store.clear();
+    store.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+      store.spawn(ParticleDesc{
+          .x = position(engine),
+          .y = position(engine),
+          .size = kBubbleSize,
+          .speed = speed(engine),
+          .wobble_amplitude = amplitude(engine),
+          .wobble_frequency = frequency(engine),
+          .wobble_phase = position(engine),
+      });
+    }
+  }
+
+  /// Rebuilds `grid` from every bubble in `store`, as the game does after
+  /// each update.
+  void build_grid(SpatialGrid& grid, const ParticleStore& store) {
+    const auto x = store.x_positions();
+    const auto y = store.y_positions();
+    const auto size = store.sizes();
+
+    for (size_t i = 0; i < store.size(); ++i) {
+      grid.insert(static_cast<uint32_t>(i), x[i], y[i], size[i] / 2);
+    }
+
+    grid.build();
+  }
+} // namespace
+
+static void BM_BubbleIntegrate(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  ParticleStore store;
+  spawn_bubbles(store, count);
+
+  // Nothing floats past this line, so every iteration moves every bubble.
+  constexpr float kDespawnY = 1e30f;
+  float time_s = 0.0f;
+
+  for (auto _ : state) {
+    time_s += kUpdateDeltaS;
+    benchmark::DoNotOptimize(store.integrate(kUpdateDeltaS, time_s, kDespawnY));
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_BubbleIntegrateParallel(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  JobSystem jobs;
+  ParticleStore store;
+  spawn_bubbles(store, count);
+
+  constexpr float kDespawnY = 1e30f;
+  float time_s = 0.0f;
+
+  for (auto _ : state) {
+    time_s += kUpdateDeltaS;
+    benchmark::DoNotOptimize(
+        store.integrate(kUpdateDeltaS, time_s, kDespawnY, jobs));
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+  state.counters["threads"] = static_cast<double>(jobs.worker_count() + 1);
+}
+
+static void BM_BubbleGridBuild(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  ParticleStore store;
+  SpatialGrid grid(kGridCellSize);
+  spawn_bubbles(store, count);
+
+  for (auto _ : state) {
+    build_grid(grid, store);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_BubbleHitTest(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  ParticleStore store;
+  SpatialGrid grid(kGridCellSize);
+  spawn_bubbles(store, count);
+  build_grid(grid, store);
+
+  // Test the same circle check the game uses for clicks at random points.
+  const auto x = store.x_positions();
+  const auto y = store.y_positions();
+  const auto size = store.sizes();
+
+  std::default_random_engine engine(5678);
+  std::uniform_real_distribution<float> position(0.0f, field_size_for(count));
+  size_t hits = 0;
+
+  for (auto _ : state) {
+    const auto click_x = position(engine);
+    const auto click_y = position(engine);
+
+    grid.query_point(click_x, click_y, [&](uint32_t i) {
+      const auto delta_x = click_x - x[i];
+      const auto delta_y = click_y - y[i];
+      const auto radius = size[i] / 2;
+
+      if (delta_x * delta_x + delta_y * delta_y < radius * radius) {
+        hits++;
+        return false;
+      }
+
+      return true;
+    });
+  }
+
+  benchmark::DoNotOptimize(hits);
+}
+
+BENCHMARK(BM_BubbleIntegrate)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK(BM_BubbleIntegrateParallel)
+    ->RangeMultiplier(10)
+    ->Range(100, 1'000'000)
+    ->UseRealTime();
+BENCHMARK(BM_BubbleGridBuild)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK(BM_BubbleHitTest)->RangeMultiplier(10)->Range(100, 1'000'000);
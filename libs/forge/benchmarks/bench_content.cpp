@@ -0,0 +1,353 @@
+#include <forge/audio_manager.h>
+#include <forge/content.h>
+#include <forge/mip_chain.h>
+#include <forge/support/sdl_support.h>
+#include <forge/support/stb_support.h>
+
+#include <benchmark/benchmark.h>
+
+#include "support/counting_stream.h"
+#include "support/software_renderer.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// These benchmarks read the game's own content files, which the build copies
+// next to the benchmark executable.
+constexpr const char* kImageFilename = "content/bubble.png";
+constexpr const char* kOggFilename = "content/pop.ogg";
+
+namespace {
+  /// Creates one second of a stereo 16-bit sine wave at `freq` Hz, which needs
+  /// both format and rate conversion to match `DEFAULT_AUDIO_SPEC`.
+  std::unique_ptr<SdlAudioBuffer> make_tone(int freq) {
+    auto buffer = std::make_unique<SdlAudioBuffer>();
+    const auto sample_count = static_cast<size_t>(freq) * 2;
+
+    buffer->spec = {.format = SDL_AUDIO_S16, .channels = 2, .freq = freq};
+    buffer->size_in_bytes =
+        static_cast<uint32_t>(sample_count * sizeof(int16_t));
+    buffer->data = static_cast<uint8_t*>(SDL_malloc(buffer->size_in_bytes));
+
+    auto samples = reinterpret_cast<int16_t*>(buffer->data);
+
+    for (size_t i = 0; i < sample_count; ++i) {
+      samples[i] = static_cast<int16_t>(
+          10000.0 * std::sin(static_cast<double>(i / 2) * 0.05));
+    }
+
+    return buffer;
+  }
+
+  /// Appends `value` to `out` as a big endian 32-bit integer.
+  void append_u32_be(std::vector<unsigned char>& out, uint32_t value) {
+    out.push_back(static_cast<unsigned char>(value >> 24));
+    out.push_back(static_cast<unsigned char>(value >> 16));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+    out.push_back(static_cast<unsigned char>(value));
+  }
+
+  uint32_t crc32(const unsigned char* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (size_t i = 0; i < size; ++i) {
+      crc ^= data[i];
+
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+      }
+    }
+
+    return ~crc;
+  }
+
+  void append_png_chunk(
+      std::vector<unsigned char>& out,
+      const char (&type)[5],
+      const unsigned char* data,
+      size_t size) {
+    append_u32_be(out, static_cast<uint32_t>(size));
+
+    const auto type_offset = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+
+    append_u32_be(
+        out,
+        crc32(out.data() + type_offset, out.size() - type_offset));
+  }
+
+  /// Encodes a `width` by `height` RGBA PNG without compression, using stored
+  /// deflate blocks split across 8 KiB IDAT chunks the way libpng writes them.
+  /// The file is large and cheap to inflate, so reading it dominates.
+  std::vector<unsigned char> make_stored_png(uint32_t width, uint32_t height) {
+    // Every row starts with a filter type byte of zero (none).
+    std::vector<unsigned char> raw;
+    raw.reserve((size_t{width} * 4 + 1) * height);
+
+    for (uint32_t y = 0; y < height; ++y) {
+      raw.push_back(0);
+
+      for (uint32_t x = 0; x < width; ++x) {
+        raw.push_back(static_cast<unsigned char>(x));
+        raw.push_back(static_cast<unsigned char>(y));
+        raw.push_back(static_cast<unsigned char>(x ^ y));
+        raw.push_back(255);
+      }
+    }
+
+    // Wrap the rows in a zlib stream of stored blocks.
+    std::vector<unsigned char> zlib{0x78, 0x01};
+    uint32_t adler_a = 1, adler_b = 0;
+
+    for (size_t offset = 0; offset < raw.size();) {
+      const auto size = std::min<size_t>(raw.size() - offset, 65535);
+      const auto is_last = offset + size == raw.size();
+
+      zlib.push_back(is_last ? 1 : 0);
+      zlib.push_back(static_cast<unsigned char>(size));
+      zlib.push_back(static_cast<unsigned char>(size >> 8));
+      zlib.push_back(static_cast<unsigned char>(~size));
+      zlib.push_back(static_cast<unsigned char>(~size >> 8));
+      zlib.insert(
+          zlib.end(),
+          raw.begin() + static_cast<ptrdiff_t>(offset),
+          raw.begin() + static_cast<ptrdiff_t>(offset + size));
+
+      for (size_t i = offset; i < offset + size; ++i) {
+        adler_a = (adler_a + raw[i]) % 65521;
+        adler_b = (adler_b + adler_a) % 65521;
+      }
+
+      offset += size;
+    }
+
+    append_u32_be(zlib, (adler_b << 16) | adler_a);
+
+    std::vector<unsigned char> png{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    std::vector<unsigned char> header;
+    append_u32_be(header, width);
+    append_u32_be(header, height);
+    header.insert(header.end(), {8, 6, 0, 0, 0}); // 8-bit RGBA
+    append_png_chunk(png, "IHDR", header.data(), header.size());
+
+    constexpr size_t kIdatChunkSize = 8192;
+
+    for (size_t offset = 0; offset < zlib.size(); offset += kIdatChunkSize) {
+      append_png_chunk(
+          png,
+          "IDAT",
+          zlib.data() + offset,
+          std::min(kIdatChunkSize, zlib.size() - offset));
+    }
+
+    append_png_chunk(png, "IEND", nullptr, 0);
+    return png;
+  }
+
+  /// Writes a 2048x2048 stored PNG to the temporary directory once, and
+  /// returns its path, or an empty path if it could not be written.
+  const std::string& large_png_path() {
+    static const auto path = [] {
+      const auto png = make_stored_png(2048, 2048);
+      auto file_path =
+          (std::filesystem::temp_directory_path() / "forge_bench_large.png")
+              .string();
+
+      std::unique_ptr<SDL_IOStream, SdlIoCloser> file{
+          SDL_IOFromFile(file_path.c_str(), "wb")};
+
+      if (file == nullptr ||
+          SDL_WriteIO(file.get(), png.data(), png.size()) != png.size()) {
+        return std::string{};
+      }
+
+      return file_path;
+    }();
+
+    return path;
+  }
+} // namespace
+
+static void BM_LoadBinary(benchmark::State& state) {
+  size_t bytes = 0;
+
+  for (auto _ : state) {
+    const auto file = load_binary(kImageFilename);
+
+    if (file.empty()) {
+      state.SkipWithError("failed to read content/bubble.png");
+      break;
+    }
+
+    bytes = file.size();
+    benchmark::DoNotOptimize(file.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+static void BM_DecodeImage(benchmark::State& state) {
+  for (auto _ : state) {
+    auto image = decode_image(kImageFilename);
+
+    if (image.pixels == nullptr) {
+      state.SkipWithError("failed to decode content/bubble.png");
+      break;
+    }
+
+    benchmark::DoNotOptimize(image.pixels.get());
+  }
+}
+
+/// Decodes a large PNG through stb_image's callbacks, either reading the file
+/// directly (block size zero) or through a `BufferedSdlReader`, and reports
+/// the reads that reach the file per decode.
+static void BM_DecodeLargePng(benchmark::State& state) {
+  const auto block_size = static_cast<size_t>(state.range(0));
+  const auto& path = large_png_path();
+
+  if (path.empty()) {
+    state.SkipWithError("failed to write large png");
+    return;
+  }
+
+  int64_t reads = 0;
+
+  for (auto _ : state) {
+    std::unique_ptr<SDL_IOStream, SdlIoCloser> file{
+        SDL_IOFromFile(path.c_str(), "rb")};
+    CountingStream counting{file.get()};
+
+    std::optional<BufferedSdlReader> reader;
+    stbi_io_callbacks stbio;
+    void* user = nullptr;
+
+    if (block_size == 0) {
+      stbio = create_stbi_sdl2_io_callbacks();
+      user = counting.stream.get();
+    } else {
+      reader.emplace(counting.stream.get(), block_size);
+      stbio = create_stbi_buffered_io_callbacks();
+      user = &*reader;
+    }
+
+    int width = 0, height = 0;
+    std::unique_ptr<unsigned char, StbImageBytesDeleter> pixels{
+        stbi_load_from_callbacks(
+            &stbio,
+            user,
+            &width,
+            &height,
+            nullptr,
+            STBI_rgb_alpha)};
+
+    if (pixels == nullptr) {
+      state.SkipWithError(stbi_failure_reason());
+      break;
+    }
+
+    benchmark::DoNotOptimize(pixels.get());
+    reads += counting.read_count;
+  }
+
+  state.counters["file_reads"] = benchmark::Counter(
+      static_cast<double>(reads),
+      benchmark::Counter::kAvgIterations);
+}
+
+static void BM_DownsampleImage(benchmark::State& state) {
+  const auto image = decode_image(kImageFilename);
+
+  if (image.pixels == nullptr) {
+    state.SkipWithError("failed to decode content/bubble.png");
+    return;
+  }
+
+  for (auto _ : state) {
+    auto half = downsample_image(image);
+    benchmark::DoNotOptimize(half.pixels.get());
+  }
+
+  state.SetBytesProcessed(
+      state.iterations() * static_cast<int64_t>(image.width) * image.height *
+      4);
+}
+
+static void BM_LoadTextureSoftware(benchmark::State& state) {
+  SoftwareRenderer software;
+
+  if (software.renderer == nullptr) {
+    state.SkipWithError(SDL_GetError());
+    return;
+  }
+
+  for (auto _ : state) {
+    auto texture = load_texture(software.renderer, kImageFilename);
+
+    if (texture == nullptr) {
+      state.SkipWithError("failed to load content/bubble.png");
+      break;
+    }
+
+    benchmark::DoNotOptimize(texture.get());
+  }
+}
+
+static void BM_LoadOgg(benchmark::State& state) {
+  for (auto _ : state) {
+    auto audio = load_ogg(kOggFilename);
+
+    if (audio == nullptr) {
+      state.SkipWithError("failed to load content/pop.ogg");
+      break;
+    }
+
+    benchmark::DoNotOptimize(audio->data);
+  }
+}
+
+static void BM_ResampleIfNeeded(benchmark::State& state) {
+  const auto freq = static_cast<int>(state.range(0));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto tone = make_tone(freq);
+    state.ResumeTiming();
+
+    auto resampled = resample_if_needed(std::move(tone), DEFAULT_AUDIO_SPEC);
+
+    if (resampled == nullptr) {
+      state.SkipWithError(SDL_GetError());
+      break;
+    }
+
+    benchmark::DoNotOptimize(resampled->data);
+  }
+
+  // One second of audio is converted per iteration.
+  state.SetItemsProcessed(state.iterations() * freq);
+}
+
+BENCHMARK(BM_LoadBinary);
+BENCHMARK(BM_DecodeImage)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DecodeLargePng)
+    ->Arg(0)
+    ->Arg(16 * 1024)
+    ->Arg(BufferedSdlReader::kDefaultBlockSize)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DownsampleImage)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoadTextureSoftware)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoadOgg)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ResampleIfNeeded)
+    ->Arg(22050)
+    ->Arg(48000)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,90 @@
+#include <forge/fast_math.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+  /// Random angles spanning several periods, similar to the wobble phases that
+  /// bubbles use.
+  std::vector<float> make_angles(size_t count) {
+    std::default_random_engine engine(1234);
+    std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+
+    std::vector<float> angles(count);
+    std::ranges::generate(angles, [&] { return distribution(engine); });
+
+    return angles;
+  }
+
+  /// Reports the largest error of `results` against a double precision sine
+  /// as a benchmark counter.
+  void report_max_error(
+      benchmark::State& state,
+      const std::vector<float>& angles,
+      const std::vector<float>& results) {
+    double max_error = 0.0;
+
+    for (size_t i = 0; i < angles.size(); ++i) {
+      max_error = std::max(
+          max_error,
+          std::abs(results[i] - std::sin(static_cast<double>(angles[i]))));
+    }
+
+    state.counters["max_error"] = max_error;
+    state.SetItemsProcessed(state.iterations() * angles.size());
+  }
+} // namespace
+
+static void BM_StdSin(benchmark::State& state) {
+  const auto angles = make_angles(state.range(0));
+  std::vector<float> results(angles.size());
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < angles.size(); ++i) {
+      results[i] = std::sin(angles[i]);
+    }
+
+    benchmark::DoNotOptimize(results.data());
+    benchmark::ClobberMemory();
+  }
+
+  report_max_error(state, angles, results);
+}
+
+static void BM_FastSinScalar(benchmark::State& state) {
+  const auto angles = make_angles(state.range(0));
+  std::vector<float> results(angles.size());
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < angles.size(); ++i) {
+      results[i] = fast_sin(angles[i]);
+    }
+
+    benchmark::DoNotOptimize(results.data());
+    benchmark::ClobberMemory();
+  }
+
+  report_max_error(state, angles, results);
+}
+
+static void BM_FastSinBulk(benchmark::State& state) {
+  const auto angles = make_angles(state.range(0));
+  std::vector<float> results(angles.size());
+
+  for (auto _ : state) {
+    fast_sin(angles, results);
+
+    benchmark::DoNotOptimize(results.data());
+    benchmark::ClobberMemory();
+  }
+
+  report_max_error(state, angles, results);
+}
+
+BENCHMARK(BM_StdSin)->Arg(4096);
+BENCHMARK(BM_FastSinScalar)->Arg(4096);
+BENCHMARK(BM_FastSinBulk)->Arg(4096);
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <forge/content.h>
+#include <forge/mip_chain.h>
+#include <forge/support/sdl_support.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class ContentCache;
+struct SDL_Renderer;
+struct SDL_Texture;
+
+/// Loads game content on a pool of worker threads so that several files can be
+/// read and decoded at the same time.
+///
+/// Files are read and decoded on a worker thread, but SDL textures must be
+/// created on the thread that owns the renderer and the `ContentCache` is not
+/// thread safe, so textures and audio are handed back by the next
+/// `process_uploads` call. `Game::iterate` does this once per frame.
+///
+/// When the loader has a cache, textures and audio that are already cached
+/// skip the workers entirely, and everything loaded is added to the cache so
+/// later requests share it.
+///
+/// # Example
+/// ```
+/// auto texture_future = loader.load_texture("content/foo.png");
+///
+/// // ... later, after `process_uploads` has run.
+/// if (texture_future.wait_for(std::chrono::seconds(0)) ==
+///     std::future_status::ready) {
+///   texture_ = texture_future.get();
+/// }
+/// ```
+class AsyncContentLoader {
+public:
+  /// Constructor.
+  ///
+  /// @param worker_count Number of worker threads to start, or zero to start
+  ///                     one worker per hardware thread.
+  /// @param cache Cache that loaded textures and audio are shared through, or
+  ///              null to not cache them. It must outlive the loader.
+  explicit AsyncContentLoader(
+      size_t worker_count = 0,
+      ContentCache* cache = nullptr);
+
+  /// Destructor. Waits for any file being decoded to finish, and abandons
+  /// requests that have not started.
+  ~AsyncContentLoader();
+
+  AsyncContentLoader(const AsyncContentLoader&) = delete;
+  AsyncContentLoader& operator=(const AsyncContentLoader&) = delete;
+
+  /// Asynchronously loads an image as a texture. See `load_texture`.
+  ///
+  /// The future is ready after the image is decoded and a later call to
+  /// `process_uploads` has created the texture, or straight away if the
+  /// texture is cached. It holds null on failure.
+  std::future<std::shared_ptr<SDL_Texture>>
+      load_texture(std::string_view filename);
+
+  /// Asynchronously decodes an image without creating a texture, for example
+  /// to add it to a `TextureAtlas`. See `decode_image`.
+  ///
+  /// The future holds an image with null `pixels` on failure.
+  std::future<DecodedImage> load_image(std::string_view filename);
+
+  /// Asynchronously decodes an image and builds its mip chain on a worker
+  /// thread. See `MipChain`.
+  ///
+  /// The future holds an empty chain on failure.
+  ///
+  /// @param min_size The smallest width or height to generate.
+  std::future<MipChain> load_mip_chain(std::string_view filename, int min_size);
+
+  /// Asynchronously loads a .ogg audio file. See `load_ogg`.
+  ///
+  /// The future is ready after the file is decoded and a later call to
+  /// `process_uploads` has handed it over, or straight away if the audio is
+  /// cached. It holds null on failure.
+  std::future<std::shared_ptr<const SdlAudioBuffer>>
+      load_ogg(std::string_view filename);
+
+  /// Asynchronously loads a .wav audio file. See `load_wav` and `load_ogg`.
+  std::future<std::shared_ptr<const SdlAudioBuffer>>
+      load_wav(std::string_view filename);
+
+  /// Creates textures for every image that finished decoding since the last
+  /// call, and hands over every audio file that finished loading. Both are
+  /// added to the cache, if there is one. This must be called on the thread
+  /// that owns the renderer and the cache.
+  ///
+  /// @param renderer The renderer to create textures with. May be null if no
+  ///                 textures were requested.
+  /// @returns The number of textures and audio files that were handed over.
+  size_t process_uploads(SDL_Renderer* renderer);
+
+  /// Get the number of requests that have not completed yet. A request stops
+  /// counting just before its future becomes ready, so this is already zero
+  /// once every future is ready.
+  size_t pending_count() const { return pending_count_.load(); }
+
+private:
+  /// An image that has been decoded and is waiting for its texture.
+  struct PendingUpload {
+    std::string filename;
+    DecodedImage image;
+    std::promise<std::shared_ptr<SDL_Texture>> texture;
+  };
+
+  /// Audio that has been loaded and is waiting to be handed over.
+  struct PendingAudio {
+    std::string filename;
+    std::unique_ptr<SdlAudioBuffer> audio;
+    std::promise<std::shared_ptr<const SdlAudioBuffer>> promise;
+  };
+
+  template<typename LoadFunc>
+  std::future<std::shared_ptr<const SdlAudioBuffer>>
+      load_audio(std::string_view filename, LoadFunc load);
+
+  void enqueue(std::packaged_task<void()> task);
+  void worker_main();
+
+private:
+  std::vector<std::thread> workers_;
+
+  std::mutex tasks_mutex_;
+  std::condition_variable tasks_cv_;
+  std::deque<std::packaged_task<void()>> tasks_;
+  bool stopping_ = false;
+
+  std::mutex uploads_mutex_;
+  std::vector<PendingUpload> uploads_;
+  std::vector<PendingAudio> audio_uploads_;
+
+  ContentCache* cache_ = nullptr;
+
+  std::atomic<size_t> pending_count_{0};
+};
@@ -1,9 +1,17 @@
 #pragma once
 
+#include <forge/audio_mixer.h>
+#include <forge/spsc_queue.h>
 #include <forge/support/sdl_support.h>
 
 #include <SDL3/SDL.h>
 
+#include <memory>
+#include <string_view>
+#include <vector>
+
+class MusicStream;
+
 constexpr auto FORGE_LOG_CATEGORY_AUDIO = SDL_LOG_CATEGORY_CUSTOM + 1;
 
 constexpr SDL_AudioSpec DEFAULT_AUDIO_SPEC{
@@ -15,8 +23,96 @@ constexpr SDL_AudioSpec DEFAULT_AUDIO_SPEC{
 class AudioManager {
 public:
   AudioManager();
+  ~AudioManager();
   SDL_AppResult init();
-  bool play_once(const SdlAudioBuffer* buffer) const;
+  bool play_once(const SdlAudioBuffer* buffer);
+
+  /// Starts playing a sound on a free mixer voice, so that it plays at the
+  /// same time as any other sounds. The buffer must use `DEFAULT_AUDIO_SPEC`
+  /// and stay alive until the sound finishes or is stopped.
+  ///
+  /// This and the other sound functions below only queue a command for the
+  /// audio thread, so they never wait on the audio device. The command takes
+  /// effect the next time the audio thread mixes.
+  ///
+  /// @returns An id for the sound, or `kInvalidVoiceId` on failure.
+  VoiceId play(const SdlAudioBuffer* buffer, const VoiceParams& params = {});
+
+  /// Stops a sound started with `play`.
+  void stop(VoiceId voice);
+
+  /// Changes the gain of a sound started with `play`.
+  void set_gain(VoiceId voice, float gain);
+
+  /// Changes the stereo pan of a sound started with `play`.
+  void set_pan(VoiceId voice, float pan);
+
+  /// Smoothly changes the gain of a sound started with `play`.
+  ///
+  /// @param target_gain Gain to reach at the end of the fade.
+  /// @param duration_s Length of the fade in seconds.
+  /// @param stop_when_done True to stop the sound when the fade finishes.
+  void fade(
+      VoiceId voice,
+      float target_gain,
+      float duration_s,
+      bool stop_when_done = false);
+
+  /// Stops every sound started with `play`. Unlike the other sound functions
+  /// this waits for the audio thread, so that the caller can free the sound
+  /// buffers as soon as it returns.
+  void stop_all_sounds();
+
+  /// Starts streaming a .ogg music track from the game's content directory,
+  /// replacing any music that is already playing. The track is decoded in
+  /// small blocks on the audio thread as it plays. See `MusicStream`.
+  ///
+  /// @param filename Path to the .ogg file relative to the content root.
+  /// @param loop True to repeat the track when it ends.
+  /// @returns True if the track started playing, false otherwise.
+  bool play_music(std::string_view filename, bool loop = true);
+
+  /// Stops the music track started by `play_music`, if any.
+  void stop_music();
+
+private:
+  /// A request from the game thread for the audio thread's mixer.
+  struct AudioCommand {
+    enum class Type { Play, Stop, SetGain, SetPan, Fade };
+
+    Type type = Type::Play;
+    VoiceId voice = kInvalidVoiceId;
+    const float* samples = nullptr;
+    size_t sample_count = 0;
+    VoiceParams params = {};
+    float value = 0.0f;
+    size_t frame_count = 0;
+    bool stop_when_done = false;
+  };
+
+  /// Queues a command for the audio thread, returning false if the queue is
+  /// full.
+  bool send(const AudioCommand& command);
+
+  /// Applies every queued command to the mixer. Must only be called by the
+  /// audio thread, or while holding the default audio stream's lock.
+  void apply_commands();
+
+  /// Mixes every playing sound when the default audio stream needs more
+  /// samples. Runs on the audio thread.
+  static void SDLCALL mix_stream_callback(
+      void* userdata,
+      SDL_AudioStream* stream,
+      int additional_amount,
+      int total_amount);
+
+  /// Decodes more of the current music track when the music audio stream needs
+  /// more samples. Runs on the audio thread.
+  static void SDLCALL music_stream_callback(
+      void* userdata,
+      SDL_AudioStream* stream,
+      int additional_amount,
+      int total_amount);
 
 private:
   int audio_device_id_{-1};
@@ -24,4 +120,25 @@ private:
 
   std::unique_ptr<SDL_AudioStream, SdlAudioStreamDestroyer>
       default_audio_stream_;
+
+  /// Mixes sounds for the default audio stream on the audio thread.
+  AudioMixer mixer_;
+
+  /// Commands from the game thread waiting to be applied to the mixer.
+  static constexpr size_t kCommandQueueCapacity = 256;
+  SpscQueue<AudioCommand, kCommandQueueCapacity> commands_;
+
+  /// Output buffer for the mixer, allocated once so the audio thread does not
+  /// allocate.
+  std::vector<float> mix_samples_;
+
+  /// The music track being played, and the audio stream that converts it to
+  /// the device format. The stream must be destroyed before the track since
+  /// the stream's callback reads from the track.
+  std::unique_ptr<MusicStream> music_;
+  std::unique_ptr<SDL_AudioStream, SdlAudioStreamDestroyer> music_audio_stream_;
+
+  /// Decode buffer used by the music stream callback, allocated once per track
+  /// so the audio thread does not allocate.
+  std::vector<float> music_samples_;
 };
\ No newline at end of file
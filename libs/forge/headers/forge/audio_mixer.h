@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/// Identifies a voice started by `AudioMixer::play`. Ids are not reused (until
+/// the 32-bit counter wraps), so an id for a voice that has finished is safely
+/// ignored.
+using VoiceId = uint32_t;
+
+/// A voice id that never refers to a playing voice.
+constexpr VoiceId kInvalidVoiceId = 0;
+
+/// Settings for a voice started by `AudioMixer::play`.
+struct VoiceParams {
+  /// Volume multiplier applied to the voice's samples.
+  float gain = 1.0f;
+  /// Stereo balance from -1 (left only) to 1 (right only).
+  float pan = 0.0f;
+  /// True to restart the sound when it reaches the end.
+  bool loop = false;
+};
+
+/// Mixes a fixed number of sounds (voices) into a single stereo F32 output so
+/// that overlapping sounds play at the same time rather than one after the
+/// other.
+///
+/// Voice storage is fixed when the mixer is created and `mix` never allocates,
+/// so it is safe to call from the audio thread. Apart from `create_voice_id`
+/// the mixer is not thread safe; the caller must make sure `play` and friends
+/// do not run at the same time as `mix`. `AudioManager` does this by sending
+/// commands to the audio thread.
+///
+/// All samples are interleaved stereo F32, matching `DEFAULT_AUDIO_SPEC`.
+/// Sample memory is not owned by the mixer and must stay valid until the voice
+/// finishes or is stopped.
+class AudioMixer {
+public:
+  /// Maximum number of voices that can play at the same time.
+  static constexpr size_t kMaxVoices = 32;
+
+  /// Start playing a sound.
+  ///
+  /// When every voice is busy the oldest non-looping voice is stopped to make
+  /// room for the new sound.
+  ///
+  /// @param samples Interleaved stereo samples of the sound.
+  /// @param params Gain, pan and looping settings for the voice.
+  /// @returns The new voice's id, or `kInvalidVoiceId` if no voice was free.
+  VoiceId play(std::span<const float> samples, const VoiceParams& params = {});
+
+  /// Start playing a sound using an id from `create_voice_id`. This lets
+  /// another thread know the id of a voice before the mixer starts it.
+  ///
+  /// @returns True if the sound started, false if no voice was free.
+  bool play(
+      VoiceId id,
+      std::span<const float> samples,
+      const VoiceParams& params = {});
+
+  /// Create a new unique voice id. This is safe to call from any thread.
+  VoiceId create_voice_id();
+
+  /// Stop a voice. Does nothing if the voice already finished.
+  void stop(VoiceId id);
+
+  /// Stop every voice.
+  void stop_all();
+
+  /// Change the gain of a playing voice.
+  void set_gain(VoiceId id, float gain);
+
+  /// Change the pan of a playing voice.
+  void set_pan(VoiceId id, float pan);
+
+  /// Smoothly change the gain of a playing voice over time.
+  ///
+  /// @param target_gain Gain to reach at the end of the fade.
+  /// @param frame_count Number of frames the fade lasts.
+  /// @param stop_when_done True to stop the voice when the fade ends, which is
+  ///                       useful for fading sounds out.
+  void fade(
+      VoiceId id,
+      float target_gain,
+      size_t frame_count,
+      bool stop_when_done = false);
+
+  /// True if the voice is still playing.
+  bool is_playing(VoiceId id) const;
+
+  /// Get the number of voices that are playing.
+  size_t active_voice_count() const;
+
+  /// Overwrite `output` with the sum of every playing voice, clamped to the
+  /// range [-1, 1]. Voices that reach the end of their sound are stopped
+  /// unless they loop.
+  ///
+  /// @param output Interleaved stereo samples to fill. The size must be a
+  ///               multiple of two.
+  void mix(std::span<float> output);
+
+private:
+  struct Voice {
+    VoiceId id = kInvalidVoiceId;
+    const float* samples = nullptr;
+    size_t frame_count = 0;
+    size_t position = 0;
+    float left_gain = 0.0f;
+    float right_gain = 0.0f;
+    float gain = 1.0f;
+    float pan = 0.0f;
+    bool loop = false;
+    bool active = false;
+    uint64_t start_order = 0;
+
+    /// Per-frame gain change, final gain and frames left while fading.
+    float fade_step = 0.0f;
+    float fade_target = 0.0f;
+    size_t fade_frames_left = 0;
+    bool stop_after_fade = false;
+  };
+
+  Voice* find(VoiceId id);
+  const Voice* find(VoiceId id) const;
+  static void update_channel_gains(Voice& voice);
+  static void mix_voice(Voice& voice, std::span<float> output);
+
+private:
+  std::array<Voice, kMaxVoices> voices_;
+  uint64_t next_start_order_ = 0;
+  std::atomic<VoiceId> next_voice_id_{1};
+};
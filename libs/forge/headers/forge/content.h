@@ -1,8 +1,11 @@
 #pragma once
 
 #include <forge/support/sdl_support.h>
+#include <forge/support/stb_support.h>
 
 #include <memory>
+#include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -18,11 +21,115 @@ struct SDL_Renderer;
 std::unique_ptr<SDL_Texture, SdlTextureCloser>
     load_texture(SDL_Renderer* renderer, std::string_view filename);
 
+/// Image pixels decoded into tightly packed 8-bit RGBA bytes.
+struct DecodedImage {
+  int width = 0;
+  int height = 0;
+  std::unique_ptr<unsigned char, StbImageBytesDeleter> pixels;
+};
+
+/// Decodes an image from the game's content directory without creating a
+/// texture. Unlike `load_texture` this does not need the renderer, and is safe
+/// to call from any thread.
+///
+/// Files outside the content archive are streamed to the decoder through a
+/// `BufferedSdlReader`, unless the decode cache is enabled. The cache reads
+/// the whole file in one read instead, since it hashes the file's bytes.
+///
+/// @returns The decoded image, or an image with null `pixels` on failure.
+DecodedImage decode_image(std::string_view filename);
+
+/// Creates a texture from an image decoded by `decode_image`. This must be
+/// called on the thread that owns the renderer.
+///
+/// The pixels are copied straight into a static texture in a layout the
+/// renderer supports natively (see `native_rgba_format`), so SDL does not
+/// convert them. The image is taken by value because its pixels may be
+/// reordered in place to match that layout.
+///
+/// @param filename Name of the image, used only for logging.
+unique_sdl_texture_ptr create_texture(
+    SDL_Renderer* renderer,
+    DecodedImage image,
+    std::string_view filename);
+
 /// Loads a file from the game's content directory and returns it as vector of
 /// bytes.
 std::vector<unsigned char> load_binary(std::string_view filename);
 
-/// Loads a .ogg audio file from the game's content directory.
+/// Mounts a packed content archive from the game's content directory. While an
+/// archive is mounted, content loading functions read files stored in the
+/// archive from memory and only fall back to the content directory for files
+/// the archive does not contain.
+///
+/// Mount the archive before loading any content, since loads that are already
+/// in progress (including on `AsyncContentLoader` worker threads) are not
+/// synchronized with mounting.
+///
+/// @returns True if the archive was mounted, false otherwise.
+bool mount_content_archive(std::string_view filename);
+
+/// Unmounts the currently mounted content archive, if any. Any `ContentBytes`
+/// that view the archive must be destroyed first.
+void unmount_content_archive();
+
+/// Enables caching decoded images and audio in a directory, so that later runs
+/// load the decoded pixels and samples instead of decoding the same files
+/// again. Cache files past `DecodeCache::kDefaultSizeLimit` are deleted,
+/// least recently used first. See `DecodeCache`.
+///
+/// Like `mount_content_archive`, enable the cache before loading any content.
+///
+/// @param directory Full path of the cache directory, ending with a path
+///                  separator. It is created if it does not exist.
+/// @returns True if the cache was enabled, false otherwise.
+bool enable_decode_cache(std::string_view directory);
+
+/// Disables the decode cache, if it is enabled. Cache files are left on disk.
+void disable_decode_cache();
+
+/// The bytes of a content file, either viewed in place in the mounted content
+/// archive or owned by this object when read from the content directory.
+class ContentBytes {
+public:
+  ContentBytes() = default;
+
+  /// Creates a view of bytes owned by someone else.
+  explicit ContentBytes(std::span<const unsigned char> view) : view_(view) {}
+
+  /// Creates bytes that own their storage.
+  explicit ContentBytes(std::vector<unsigned char> storage)
+      : storage_(std::move(storage)) {}
+
+  /// Get the file's bytes.
+  std::span<const unsigned char> bytes() const {
+    return storage_.empty() ? view_ : std::span{storage_};
+  }
+
+  /// True if there are no bytes, which includes failing to read the file.
+  bool empty() const { return bytes().empty(); }
+
+private:
+  std::span<const unsigned char> view_;
+  std::vector<unsigned char> storage_;
+};
+
+/// Reads a file from the mounted content archive without copying it, or from
+/// the game's content directory if no archive contains the file.
+///
+/// # Example
+/// ```
+/// auto font_file = read_content("content/font.fnt");
+/// auto result = read_bmfont(font_file.bytes());
+/// ```
+ContentBytes read_content(std::string_view filename);
+
+/// Converts a content path into a canonical form by removing redundant `.` and
+/// `..` segments and using `/` as the separator.
+std::string normalize_content_path(std::string_view filename);
+
+/// Loads a .ogg audio file from the game's content directory. The entire file
+/// is decoded into memory, so use `MusicStream` for long music tracks.
 std::unique_ptr<SdlAudioBuffer> load_ogg(std::string_view filename);
 
 /// Loads a .wav audio file from the game's content directory.
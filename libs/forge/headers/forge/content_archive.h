@@ -0,0 +1,64 @@
+#pragma once
+
+#include <forge/content_archive_format.h>
+#include <forge/support/mapped_file.h>
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/// Reads files from a packed content archive written by the `content_packer`
+/// tool.
+///
+/// The archive is memory mapped when it is opened, and files are returned as
+/// views directly into the mapping without copying them. Packing many small
+/// files into one archive replaces an open, stat and read per file with a
+/// single mapping of the whole archive.
+///
+/// A `ContentArchive` is immutable once opened, so `find` can be called from
+/// any thread.
+///
+/// # Example
+/// ```
+/// auto archive = ContentArchive::open(full_path);
+/// auto bytes = archive->find("content/foo.png");
+///
+/// if (bytes.has_value()) {
+///   // ... decode `*bytes`.
+/// }
+/// ```
+class ContentArchive {
+public:
+  /// Opens and validates a content archive.
+  ///
+  /// @param path Full path to the archive file.
+  /// @returns The opened archive, or null if it could not be opened or is not
+  ///          a valid archive.
+  static std::unique_ptr<ContentArchive> open(const std::string& path);
+
+  /// Get the bytes of a file stored in the archive. The returned view is valid
+  /// for the lifetime of the archive.
+  ///
+  /// @param filename Path of the file relative to the content root, for
+  ///                 example "content/foo.png".
+  /// @returns The file's bytes, or no value if the archive does not contain
+  ///          the file.
+  std::optional<std::span<const unsigned char>>
+      find(std::string_view filename) const;
+
+  /// Get the number of files stored in the archive.
+  size_t size() const { return entries_.size(); }
+
+private:
+  explicit ContentArchive(std::unique_ptr<MappedFile> file);
+
+  bool validate(const std::string& path);
+  std::string_view entry_path(const ContentArchiveEntry& entry) const;
+
+private:
+  std::unique_ptr<MappedFile> file_;
+  std::vector<ContentArchiveEntry> entries_;
+  std::string_view path_table_;
+};
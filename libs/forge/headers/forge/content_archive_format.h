@@ -0,0 +1,54 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+// This header describes the on-disk layout of packed content archives. It is
+// shared by the forge runtime and the `content_packer` build tool, so it must
+// only depend on the C++ standard library.
+//
+// An archive is laid out as:
+//
+//   ContentArchiveHeader
+//   ContentArchiveEntry[entry_count], sorted by path
+//   path table, `path_table_size` bytes of concatenated paths (no terminators)
+//   file bytes, each file starting on a `kContentArchiveAlignment` boundary
+//
+// All integers are little endian, and all offsets are from the start of the
+// archive.
+
+static_assert(
+    std::endian::native == std::endian::little,
+    "content archives are read and written as little endian");
+
+/// First four bytes of every content archive.
+constexpr char kContentArchiveMagic[4] = {'F', 'P', 'A', 'K'};
+
+/// Version of the archive layout described by this header.
+constexpr uint32_t kContentArchiveVersion = 1;
+
+/// Byte alignment of every file stored in an archive.
+constexpr uint64_t kContentArchiveAlignment = 16;
+
+/// Header at the start of a content archive.
+struct ContentArchiveHeader {
+  char magic[4] = {};
+  uint32_t version = 0;
+  uint32_t entry_count = 0;
+  uint32_t path_table_size = 0;
+};
+
+/// Describes one file stored in a content archive.
+struct ContentArchiveEntry {
+  /// Offset of the file's first byte.
+  uint64_t offset = 0;
+  /// Size of the file in bytes.
+  uint64_t size = 0;
+  /// Offset of the file's path relative to the start of the path table.
+  uint32_t path_offset = 0;
+  /// Length of the file's path in bytes.
+  uint32_t path_length = 0;
+};
+
+static_assert(sizeof(ContentArchiveHeader) == 16);
+static_assert(sizeof(ContentArchiveEntry) == 24);
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <forge/support/sdl_support.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+/// Caches loaded game content by path so that each file is read and decoded at
+/// most once while it stays resident.
+///
+/// Content is handed out as `std::shared_ptr` handles. An entry is considered
+/// referenced while any handle other than the cache's own is alive. When the
+/// estimated memory of all cached content exceeds the memory budget, the
+/// least recently requested unreferenced entries are evicted. Referenced
+/// entries are never evicted, so the budget can be exceeded while the game
+/// holds on to more content than fits.
+///
+/// Sounds are mixed straight from their `SdlAudioBuffer`, and a sound started
+/// with `AudioManager::play` does not hold a handle. Keep an audio handle alive
+/// until every sound played from it has finished or been stopped, since the
+/// entry can be evicted as soon as the last handle is dropped.
+///
+/// The cache is not thread safe and must be used on the thread that owns the
+/// renderer. `AsyncContentLoader` can load content on worker threads and add it
+/// to the cache from that thread.
+///
+/// # Example
+/// ```
+/// ContentCache cache{renderer};
+///
+/// auto a = cache.texture("content/foo.png");
+/// auto b = cache.texture("content/../content/foo.png"); // same texture as a.
+/// ```
+class ContentCache {
+public:
+  /// Default memory budget for cached content.
+  static constexpr size_t kDefaultMemoryBudget = 256 * 1024 * 1024;
+
+  /// Constructor.
+  ///
+  /// @param renderer The renderer used to create textures, or null if the
+  ///                 cache only holds audio.
+  /// @param memory_budget Estimated number of bytes that cached content may use
+  ///                      before unreferenced entries are evicted.
+  explicit ContentCache(
+      SDL_Renderer* renderer = nullptr,
+      size_t memory_budget = kDefaultMemoryBudget);
+
+  /// Get a texture for an image in the game's content directory, loading it
+  /// if it is not already cached. See `load_texture`.
+  ///
+  /// @returns A handle to the texture, or null if loading failed or the cache
+  ///          has no renderer.
+  std::shared_ptr<SDL_Texture> texture(std::string_view filename);
+
+  /// Get a .ogg audio file from the game's content directory, loading it if it
+  /// is not already cached. See `load_ogg`.
+  ///
+  /// @returns A handle to the audio, or null if loading failed.
+  std::shared_ptr<const SdlAudioBuffer> ogg(std::string_view filename);
+
+  /// Get a .wav audio file from the game's content directory, loading it if it
+  /// is not already cached. See `load_wav`.
+  ///
+  /// @returns A handle to the audio, or null if loading failed.
+  std::shared_ptr<const SdlAudioBuffer> wav(std::string_view filename);
+
+  /// Get a texture that is already cached, without loading it.
+  ///
+  /// @returns A handle to the texture, or null if it is not cached.
+  std::shared_ptr<SDL_Texture> find_texture(std::string_view filename);
+
+  /// Get audio that is already cached, without loading it.
+  ///
+  /// @returns A handle to the audio, or null if it is not cached.
+  std::shared_ptr<const SdlAudioBuffer> find_audio(std::string_view filename);
+
+  /// Adds a texture that was loaded elsewhere, for example on a worker thread.
+  /// If `filename` is already cached the new texture is discarded.
+  ///
+  /// @returns A handle to the cached texture.
+  std::shared_ptr<SDL_Texture>
+      add_texture(std::string_view filename, unique_sdl_texture_ptr texture);
+
+  /// Adds audio that was loaded elsewhere, for example on a worker thread. If
+  /// `filename` is already cached the new audio is discarded.
+  ///
+  /// @returns A handle to the cached audio.
+  std::shared_ptr<const SdlAudioBuffer> add_audio(
+      std::string_view filename,
+      std::unique_ptr<SdlAudioBuffer> audio);
+
+  /// Change the memory budget, and evict unreferenced entries if the cache is
+  /// now over budget.
+  void set_memory_budget(size_t memory_budget);
+
+  /// Get the memory budget in bytes.
+  size_t memory_budget() const { return memory_budget_; }
+
+  /// Get the estimated number of bytes used by all cached content.
+  size_t memory_used() const { return memory_used_; }
+
+  /// Get the number of cached entries.
+  size_t size() const { return entries_.size(); }
+
+  /// Evict the least recently requested unreferenced entries until the cache
+  /// is within its memory budget.
+  ///
+  /// @returns The number of entries that were evicted.
+  size_t trim();
+
+  /// Evict every unreferenced entry regardless of the memory budget.
+  ///
+  /// @returns The number of entries that were evicted.
+  size_t evict_unreferenced();
+
+  /// Converts a content path into the form used as a cache key. See
+  /// `normalize_content_path`.
+  static std::string normalize_path(std::string_view filename);
+
+private:
+  struct Entry {
+    std::shared_ptr<SDL_Texture> texture;
+    std::shared_ptr<const SdlAudioBuffer> audio;
+    size_t size_in_bytes = 0;
+    uint64_t last_used = 0;
+
+    bool is_referenced() const;
+  };
+
+  Entry* find(const std::string& key);
+  void insert(std::string key, Entry entry);
+
+  std::shared_ptr<SDL_Texture>
+      insert_texture(std::string key, std::shared_ptr<SDL_Texture> texture);
+  std::shared_ptr<const SdlAudioBuffer> insert_audio(
+      std::string key,
+      std::shared_ptr<const SdlAudioBuffer> audio);
+
+  template<typename LoadFunc>
+  std::shared_ptr<const SdlAudioBuffer>
+      cached_audio(std::string_view filename, LoadFunc&& load);
+
+private:
+  SDL_Renderer* renderer_ = nullptr;
+  size_t memory_budget_ = 0;
+  size_t memory_used_ = 0;
+  uint64_t use_counter_ = 0;
+  std::unordered_map<std::string, Entry> entries_;
+};
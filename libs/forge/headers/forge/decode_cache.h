@@ -0,0 +1,168 @@
+#pragma once
+
+#include <forge/content.h>
+
+#include <SDL3/SDL_audio.h>
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+
+// A decode cache file is laid out as:
+//
+//   DecodeCacheHeader
+//   payload, `payload_size` bytes of RGBA pixels or interleaved PCM samples
+//
+// All integers are little endian. Cache files are only ever read back by the
+// build that wrote them, so any change to the layout or to the decoders must
+// bump `kDecodeCacheVersion`.
+
+static_assert(
+    std::endian::native == std::endian::little,
+    "decode cache files are read and written as little endian");
+
+/// First four bytes of every decode cache file.
+constexpr char kDecodeCacheMagic[4] = {'F', 'D', 'A', 'C'};
+
+/// Version of the cache layout and of the decoded payloads stored in it.
+constexpr uint32_t kDecodeCacheVersion = 1;
+
+/// Kind of payload stored in a decode cache file.
+enum class DecodeCacheKind : uint32_t {
+  Image = 1,
+  Audio = 2,
+};
+
+/// Header at the start of a decode cache file.
+struct DecodeCacheHeader {
+  char magic[4] = {};
+  uint32_t version = 0;
+  /// Hash of the source file's bytes and the payload's format. Also used as
+  /// the cache file's name.
+  uint64_t key = 0;
+  /// Size of the source file in bytes.
+  uint64_t source_size = 0;
+  /// A `DecodeCacheKind`.
+  uint32_t kind = 0;
+  /// `SDL_PIXELFORMAT_RGBA32` for images, or the `SDL_AudioFormat` of audio.
+  uint32_t format = 0;
+  /// Image width, or audio channel count.
+  int32_t width_or_channels = 0;
+  /// Image height, or audio sample rate.
+  int32_t height_or_freq = 0;
+  /// Size of the payload following the header in bytes.
+  uint64_t payload_size = 0;
+};
+
+static_assert(sizeof(DecodeCacheHeader) == 48);
+
+/// Hashes bytes with the 64-bit xxHash algorithm (XXH64), which reads several
+/// gigabytes per second and is far cheaper than decoding the same bytes.
+///
+/// @param seed Value mixed into the hash, so the same bytes can be hashed into
+///             independent keys.
+uint64_t hash_bytes(std::span<const unsigned char> bytes, uint64_t seed = 0);
+
+/// Stores decoded content in a directory so later runs can skip decoding.
+///
+/// Images are cached as RGBA pixels and audio as PCM samples that have already
+/// been resampled to their target spec, so a cache hit only copies the payload
+/// out of a memory mapped file. Entries are keyed by a hash of the source
+/// file's bytes and the target format, which means editing a source file or
+/// changing the target format simply misses the cache. Stale entries are never
+/// read again, so the cache files are kept under a size limit by deleting the
+/// least recently used ones, see `trim`.
+///
+/// Entries are written to a temporary file and renamed into place, so every
+/// method can be called from any thread and readers never see a partial entry.
+///
+/// # Example
+/// ```
+/// DecodeCache cache(cache_directory);
+/// auto source = read_content("content/foo.png");
+/// auto image = cache.find_image(source.bytes());
+///
+/// if (!image.has_value()) {
+///   // ... decode `source` and `cache.store_image(source.bytes(), decoded)`.
+/// }
+/// ```
+class DecodeCache {
+public:
+  /// Default number of bytes that cache files may use on disk.
+  static constexpr uint64_t kDefaultSizeLimit = 256ull * 1024 * 1024;
+
+  /// Constructor. Trims the directory down to `size_limit`.
+  ///
+  /// @param directory Directory that cache files are stored in, ending with a
+  ///                  path separator. It must already exist.
+  /// @param size_limit Number of bytes that cache files may use on disk
+  ///                   before the least recently used ones are deleted.
+  explicit DecodeCache(
+      std::string directory,
+      uint64_t size_limit = kDefaultSizeLimit);
+
+  /// Get the cached RGBA pixels decoded from `source`.
+  ///
+  /// @returns The image, or no value if it is not cached.
+  std::optional<DecodedImage>
+      find_image(std::span<const unsigned char> source) const;
+
+  /// Caches the RGBA pixels decoded from `source`.
+  ///
+  /// @returns True if the entry was written, false otherwise.
+  bool store_image(
+      std::span<const unsigned char> source,
+      const DecodedImage& image) const;
+
+  /// Get the cached samples decoded from `source` and converted to `spec`.
+  ///
+  /// @returns The samples, or null if they are not cached.
+  std::unique_ptr<SdlAudioBuffer> find_audio(
+      std::span<const unsigned char> source,
+      const SDL_AudioSpec& spec) const;
+
+  /// Caches the samples decoded from `source`, which are keyed by the
+  /// buffer's spec.
+  ///
+  /// @returns True if the entry was written, false otherwise.
+  bool store_audio(
+      std::span<const unsigned char> source,
+      const SdlAudioBuffer& buffer) const;
+
+  /// Deletes the least recently used cache files until the rest use at most
+  /// three quarters of the size limit, leaving room for new entries before the
+  /// next trim. Does nothing if the files are within the size limit.
+  ///
+  /// Called by the constructor, and by `store_image` and `store_audio` once
+  /// the entries they write take the cache over its size limit.
+  ///
+  /// @returns Number of cache files deleted.
+  size_t trim() const;
+
+  /// Get the directory that cache files are stored in.
+  const std::string& directory() const { return directory_; }
+
+  /// Get the number of bytes that cache files may use on disk.
+  uint64_t size_limit() const { return size_limit_; }
+
+private:
+  std::string entry_path(uint64_t key) const;
+
+  bool write_entry(
+      const DecodeCacheHeader& header,
+      std::span<const unsigned char> payload) const;
+
+private:
+  std::string directory_;
+  uint64_t size_limit_;
+  /// Bytes used by cache files as of the last trim, plus the entries written
+  /// since.
+  mutable std::atomic<uint64_t> size_used_ = 0;
+  /// Serializes trims, so concurrent stores do not sweep the directory twice.
+  mutable std::mutex trim_mutex_;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <span>
+
+/// Largest absolute error of `fast_sin` and `fast_cos` compared to the exact
+/// result for inputs in [-kFastTrigMaxInput, kFastTrigMaxInput].
+constexpr float kFastTrigMaxError = 5e-7f;
+
+/// Largest input magnitude covered by `kFastTrigMaxError`. Larger inputs are
+/// still reduced correctly but lose precision as the input grows.
+constexpr float kFastTrigMaxInput = 8192.0f;
+
+/// Approximates `sin(x)` in single precision using range reduction and a
+/// polynomial. Prefer the span overload when evaluating many values since it
+/// is several times faster than calling this in a loop.
+float fast_sin(float x);
+
+/// Approximates `cos(x)` in single precision using range reduction and a
+/// polynomial. Prefer the span overload when evaluating many values since it
+/// is several times faster than calling this in a loop.
+float fast_cos(float x);
+
+/// Writes `fast_sin(x[i])` to `out[i]` for every element of `x`, processing
+/// four or eight elements at once depending on the available SIMD instructions.
+///
+/// `out` must be at least as large as `x`, and the two spans may be the same
+/// memory.
+void fast_sin(std::span<const float> x, std::span<float> out);
+
+/// Writes `fast_cos(x[i])` to `out[i]` for every element of `x`, processing
+/// four or eight elements at once depending on the available SIMD instructions.
+///
+/// `out` must be at least as large as `x`, and the two spans may be the same
+/// memory.
+void fast_cos(std::span<const float> x, std::span<float> out);
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// Summary statistics for a set of recorded durations, in milliseconds.
+struct TimingSummary {
+  uint64_t count = 0;
+  double min_ms = 0.0;
+  double max_ms = 0.0;
+  double average_ms = 0.0;
+  double p50_ms = 0.0;
+  double p95_ms = 0.0;
+  double p99_ms = 0.0;
+};
+
+/// A lock-free histogram of durations used to estimate percentiles without
+/// storing every sample.
+///
+/// Buckets are log-linear: every power of two is split into eight equal
+/// sub-buckets, so a percentile is accurate to within about 6% of the true
+/// value at any magnitude. Durations from 1 ns up to about 18 minutes are
+/// bucketed and anything longer lands in the last bucket.
+///
+/// `record` is safe to call from any number of threads at once. Reading the
+/// histogram while it is being written gives an approximate result.
+class TimingHistogram {
+public:
+  /// Number of sub-buckets each power of two is divided into, as a power of
+  /// two.
+  static constexpr unsigned kSubBucketBits = 3;
+  static constexpr uint64_t kSubBucketCount = 1 << kSubBucketBits;
+
+  /// Durations at or above 2^kMaxExponent nanoseconds share the last bucket.
+  static constexpr unsigned kMaxExponent = 40;
+  static constexpr size_t kBucketCount =
+      (kMaxExponent - kSubBucketBits + 1) * kSubBucketCount;
+
+  /// Add a duration to the histogram.
+  void record(uint64_t duration_ns);
+
+  /// Remove every recorded duration.
+  void reset();
+
+  /// Get the number of recorded durations.
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+  /// Estimate the duration below which `fraction` (0 to 1) of the recorded
+  /// durations fall.
+  uint64_t percentile_ns(double fraction) const;
+
+  /// Get summary statistics for every recorded duration.
+  TimingSummary summarize() const;
+
+  /// Get the index of the bucket that holds a duration.
+  static size_t bucket_index(uint64_t duration_ns);
+
+  /// Get the smallest duration that lands in a bucket.
+  static uint64_t bucket_lower_bound(size_t index);
+
+private:
+  std::array<std::atomic<uint32_t>, kBucketCount> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> total_ns_{0};
+  std::atomic<uint64_t> min_ns_{UINT64_MAX};
+  std::atomic<uint64_t> max_ns_{0};
+};
+
+/// The parts of a frame timed by `FrameProfiler`.
+enum class FramePhase {
+  Upload, /// Loaded textures and atlas pages uploaded before input.
+  Input,  /// `Game::on_input` and `Game::on_render_resized`.
+  Update, /// Every `Game::on_update` call made during the frame.
+  Render, /// `Game::on_render`.
+  Frame,  /// The entire `Game::iterate` call.
+};
+
+/// Number of values in `FramePhase`.
+constexpr size_t kFramePhaseCount = 5;
+
+/// Measures how long each phase of a frame takes, and periodically reports
+/// percentiles, min/max/average and calls per second for each phase.
+///
+/// Durations are measured with `SDL_GetPerformanceCounter`. Statistics are
+/// gathered over a reporting window; at the end of each window the results are
+/// published to `report` and optionally written to the log, and a new window
+/// begins.
+///
+/// # Example
+/// ```
+/// const auto start = FrameProfiler::now();
+/// // ... render.
+/// profiler.record(FramePhase::Render, start, FrameProfiler::now());
+///
+/// profiler.end_frame();
+/// ```
+class FrameProfiler {
+public:
+  /// Statistics for every phase over one reporting window.
+  struct Report {
+    std::array<TimingSummary, kFramePhaseCount> phases;
+    double window_s = 0.0;
+
+    /// Get the statistics for one phase.
+    const TimingSummary& operator[](FramePhase phase) const {
+      return phases[static_cast<size_t>(phase)];
+    }
+
+    /// Get the number of times a phase ran per second.
+    double calls_per_second(FramePhase phase) const {
+      return window_s > 0.0 ? (*this)[phase].count / window_s : 0.0;
+    }
+  };
+
+  /// Constructor.
+  ///
+  /// @param report_interval_s Length of a reporting window in seconds.
+  explicit FrameProfiler(double report_interval_s = 5.0);
+
+  /// Get the current value of the performance counter.
+  static uint64_t now();
+
+  /// Record the time taken by one run of a phase. Safe to call from any
+  /// thread.
+  ///
+  /// @param start Performance counter value when the phase started.
+  /// @param end Performance counter value when the phase ended.
+  void record(FramePhase phase, uint64_t start, uint64_t end);
+
+  /// Call once at the end of each frame. Publishes a new report and starts a
+  /// new window if the reporting interval has passed.
+  ///
+  /// @returns True if a new report was published.
+  bool end_frame();
+
+  /// Get the statistics from the last completed window.
+  const Report& report() const { return report_; }
+
+  /// Get statistics for one phase in the current, incomplete window.
+  TimingSummary current(FramePhase phase) const;
+
+  /// Enable or disable writing a log line each time a report is published.
+  void set_logging_enabled(bool enabled) { logging_enabled_ = enabled; }
+
+private:
+  void log_report() const;
+
+private:
+  std::array<TimingHistogram, kFramePhaseCount> histograms_;
+  Report report_;
+  uint64_t window_start_ = 0;
+  uint64_t report_interval_ticks_ = 0;
+  double ns_per_tick_ = 0.0;
+  bool logging_enabled_ = true;
+};
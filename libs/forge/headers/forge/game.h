@@ -1,10 +1,96 @@
 #pragma once
 
+#include <forge/frame_arena.h>
+#include <forge/frame_profiler.h>
+#include <forge/input_queue.h>
 #include <forge/support/sdl_support.h>
 
 #include <SDL3/SDL.h>
 
+#include <functional>
+#include <span>
+
+class AsyncContentLoader;
 class AudioManager;
+class ContentCache;
+class JobSystem;
+class TextureAtlas;
+
+/// Controls how `Game::iterate` catches up when more than
+/// `Game::max_updates_per_frame` fixed updates are owed in a single frame,
+/// which happens after a long stall or when updates take longer than the time
+/// they simulate.
+enum class CatchUpPolicy {
+  /// Limit the time measured for the frame so that exactly
+  /// `max_updates_per_frame` updates are owed. Time past the limit, including
+  /// any partial update, is never simulated, and inputs and rendering see the
+  /// limited frame time. The time removed is counted in
+  /// `LoopStats::clamped_time_ns`.
+  Clamp,
+  /// Run `max_updates_per_frame` updates and then discard the rest of the
+  /// whole updates owed. The simulation skips ahead to the present and keeps
+  /// the partial update, so inputs and rendering see the real frame time. The
+  /// updates removed are counted in `LoopStats::dropped_updates`.
+  Drop,
+  /// Run `max_updates_per_frame` updates and carry the rest over to later
+  /// frames, so the simulation runs slower than real time until it catches up.
+  /// At most `max_updates_per_frame` updates are carried over.
+  SlowMotion,
+};
+
+/// Counters describing how the fixed timestep loop in `Game::iterate` has run
+/// since the game started.
+struct LoopStats {
+  /// Number of `iterate` calls.
+  uint64_t frames = 0;
+  /// Number of `on_update` calls.
+  uint64_t updates = 0;
+  /// Number of frames that owed more than `max_updates_per_frame` updates.
+  uint64_t overruns = 0;
+  /// Number of owed updates that were discarded rather than run, by
+  /// `CatchUpPolicy::Drop` or `CatchUpPolicy::SlowMotion`.
+  uint64_t dropped_updates = 0;
+  /// Nanoseconds of frame time that `CatchUpPolicy::Clamp` removed rather than
+  /// simulated.
+  uint64_t clamped_time_ns = 0;
+  /// The most updates owed by a single frame.
+  uint64_t max_updates_owed = 0;
+};
+
+/// The result of applying a `CatchUpPolicy` to one frame. See
+/// `plan_catch_up`.
+struct CatchUpPlan {
+  /// Updates owed before the policy was applied.
+  Uint64 updates_owed = 0;
+  /// Scaled lag that the frame's updates are run from. See
+  /// `plan_catch_up`.
+  Uint64 scaled_lag = 0;
+  /// Frame time in nanoseconds that inputs and rendering see.
+  Uint64 elapsed_time_ns = 0;
+  /// Whole updates that were discarded.
+  Uint64 dropped_updates = 0;
+  /// Nanoseconds of frame time that were discarded.
+  Uint64 clamped_time_ns = 0;
+};
+
+/// Works out how one frame of the fixed timestep loop catches up when it owes
+/// more than `max_updates_per_frame` updates. This does no work itself, so the
+/// policies can be checked without running a game.
+///
+/// Lag is measured in nanoseconds multiplied by the update rate, so one update
+/// is always exactly `SDL_NS_PER_SECOND` of scaled lag.
+///
+/// @param scaled_lag Scaled lag left over from the previous frame.
+/// @param elapsed_time_ns Time since the previous frame in nanoseconds.
+/// @param update_rate_hz Number of game logic updates per second.
+/// @param max_updates_per_frame Most updates that one frame may run.
+/// @param policy What to do when more updates are owed than that.
+CatchUpPlan plan_catch_up(
+    Uint64 scaled_lag,
+    Uint64 elapsed_time_ns,
+    Uint32 update_rate_hz,
+    Uint64 max_updates_per_frame,
+    CatchUpPolicy policy);
 
 /// The base class for all Forge games and is responsible for handling the
 /// common application logic required for all games.
@@ -27,7 +113,8 @@ public:
   /// Initializes the game.
   SDL_AppResult init();
 
-  /// Handle an event received from the host platform.
+  /// Handle an event received from the host platform. Input events are queued
+  /// and passed to `on_input` at the start of the next `iterate` call.
   SDL_AppResult handle_event(const SDL_Event* event);
 
   /// Advance the game's simulation logic and rendering.
@@ -39,21 +126,84 @@ public:
   /// Get the height of the main rendering window in pixel units.
   int pixel_height() const { return pixel_height_; }
 
+  /// Get the number of render pixels per window coordinate unit.
+  float pixel_density() const { return pixel_density_; }
+
+  /// Get counters describing how the fixed timestep loop has run.
+  const LoopStats& loop_stats() const { return loop_stats_; }
+
+  /// Get the policy used when the fixed timestep loop falls behind.
+  CatchUpPolicy catch_up_policy() const { return catch_up_policy_; }
+
+  /// Set the policy used when the fixed timestep loop falls behind.
+  void set_catch_up_policy(CatchUpPolicy policy) { catch_up_policy_ = policy; }
+
+  /// Replace the clock that `iterate` uses to measure elapsed time, for example
+  /// with a simulated clock that makes benchmarks and tests deterministic.
+  ///
+  /// @param clock_ns Returns the current time in nanoseconds, or an empty
+  ///                 function to use `SDL_GetTicksNS`.
+  void set_clock(std::function<Uint64()> clock_ns) {
+    clock_ns_ = std::move(clock_ns);
+  }
+
+  /// Get the number of game logic updates per second.
+  Uint32 update_rate() const { return update_rate_hz_; }
+
+  /// Set the number of game logic updates per second, for example 30, 60, 120
+  /// or 240. Values less than one are treated as one.
+  void set_update_rate(Uint32 rate_hz);
+
+  /// Get the amount of time simulated by each game logic update in seconds.
+  float update_delta_s() const { return 1.0f / update_rate_hz_; }
+
+  /// Get the maximum number of `on_update` calls made in one frame.
+  Uint64 max_updates_per_frame() const { return max_updates_per_frame_; }
+
+  /// Set the maximum number of `on_update` calls made in one frame. Values less
+  /// than one are treated as one.
+  void set_max_updates_per_frame(Uint64 count) {
+    max_updates_per_frame_ = count > 0 ? count : 1;
+  }
+
+  /// Get the arena for memory that is only needed until the end of the
+  /// current frame. The arena is reset at the start of every `iterate` call.
+  FrameArena& frame_arena() { return frame_arena_; }
+
+  /// Get a memory resource backed by `frame_arena`, for use with `std::pmr`
+  /// containers that are discarded by the end of the frame.
+  std::pmr::memory_resource* frame_memory() { return &frame_memory_; }
+
+  /// Get the profiler that times each phase of `iterate`.
+  FrameProfiler& profiler() { return profiler_; }
+
+  /// Get the profiler that times each phase of `iterate`.
+  const FrameProfiler& profiler() const { return profiler_; }
+
 protected:
   /// Called at the end of the game initialization phase.
   virtual SDL_AppResult on_init();
 
-  /// Called every update to allow a game to respond to player inputs.
+  /// Called every frame to allow a game to respond to player inputs.
+  ///
+  /// The default implementation calls `on_mouse_click` or
+  /// `on_touch_finger_down` for each event. Override it to handle the whole
+  /// batch at once, for example to hit test every click against the same
+  /// spatial index.
   ///
   /// @param delta_s The amount of time that has elapsed in seconds since the
   ///                last call to this function.
-  virtual SDL_AppResult on_input(float delta_s);
+  /// @param pointer_events Clicks and touches received since the last frame,
+  ///                       oldest first.
+  virtual SDL_AppResult on_input(
+      float delta_s,
+      std::span<const PointerEvent> pointer_events);
 
   /// Called to update the game's simulation logic on a fixed timestep
   /// frequency.
   ///
   /// @param delta_s The amount of time that has elapsed in seconds since the
-  ///                last call to this function (always `kMsPerUpdate`).
+  ///                last call to this function (always `update_delta_s`).
   virtual SDL_AppResult on_update(float delta_s);
 
   /// Called to render the game's simulation state.
@@ -64,13 +214,16 @@ protected:
   ///                      time between the last update and the upcoming update.
   virtual SDL_AppResult on_render(float delta_s, float extrapolation);
 
-  /// Called when the main render window is resized.
+  /// Called before `on_input` when the main render window was resized since
+  /// the last frame. Only the most recent size is reported.
   virtual SDL_AppResult on_render_resized(int width, int height);
 
-  /// Called when the mouse is clicked inside the main render window.
+  /// Called by the default `on_input` when the mouse is clicked inside the
+  /// main render window.
   virtual SDL_AppResult on_mouse_click(int mouse_x, int mouse_y);
 
-  /// Called when a finger is starts touching inside the main render window.
+  /// Called by the default `on_input` when a finger starts touching inside the
+  /// main render window.
   virtual SDL_AppResult on_touch_finger_down(int touch_x, int touch_y);
 
 protected:
@@ -80,9 +233,36 @@ protected:
   /// Game audio manager.
   std::unique_ptr<AudioManager> audio_;
 
+  /// Shares loaded game content between everything that requests the same
+  /// file, and evicts unused content when over its memory budget.
+  std::unique_ptr<ContentCache> content_cache_;
+
+  /// Loads game content on worker threads and adds it to `content_cache_`.
+  /// Textures and audio requested through the loader are handed over at the
+  /// start of each `iterate` call.
+  std::unique_ptr<AsyncContentLoader> content_loader_;
+
+  /// Packs sprite images into shared textures so that sprites drawn from
+  /// different images can be batched together. Images added to the atlas are
+  /// uploaded at the start of each `iterate` call.
+  std::unique_ptr<TextureAtlas> texture_atlas_;
+
+  /// Runs jobs on worker threads, so that `on_update` and other per-frame work
+  /// can be spread over every core.
+  std::unique_ptr<JobSystem> jobs_;
+
   /// The game's main window.
   unique_sdl_window_ptr window_;
 
+  /// Times the input, update and render phases of each frame.
+  FrameProfiler profiler_;
+
+  /// Transient memory that is released at the start of every frame.
+  FrameArena frame_arena_;
+
+  /// Adapts `frame_arena_` for `std::pmr` containers.
+  FrameArenaResource frame_memory_{frame_arena_};
+
   /// True if the game should exit, false otherwise.
   bool quit_requested_ = false;
 
@@ -92,15 +272,53 @@ protected:
   /// Height of the main rendering window in pixels.
   int pixel_height_ = 0;
 
+  /// Render pixels per window coordinate unit, refreshed when the window's
+  /// pixel size changes.
+  float pixel_density_ = 1.0f;
+
 public:
-  /// The number of milliseconds between game logic updates.
-  static constexpr Uint64 kMsPerUpdate = 16; // about 60/sec.
+  /// Name of the packed content archive that is mounted at start up if it
+  /// exists next to the game's content directory.
+  static constexpr const char* kContentArchiveFilename = "content.fpak";
+
+  /// Organization and application names passed to `SDL_GetPrefPath`, which
+  /// pick the per-user directory that the decode cache is stored in.
+  static constexpr const char* kPrefPathOrganization = "forge";
+  static constexpr const char* kPrefPathApplication = "xplat_sdl3";
+
+  /// The default number of game logic updates per second.
+  static constexpr Uint32 kDefaultUpdateRate = 60;
+
+  /// The default maximum number of game logic updates run in one frame.
+  static constexpr Uint64 kDefaultMaxUpdatesPerFrame = 5;
 
 private:
-  /// The last time `on_iterate` was called.
-  Uint64 previous_time_ms_ = 0;
+  /// Replaces `SDL_GetTicksNS` as the source of time when set.
+  std::function<Uint64()> clock_ns_;
+
+  /// The last time `on_iterate` was called, in nanoseconds.
+  Uint64 previous_time_ns_ = 0;
+
+  /// The number of game logic updates per second.
+  Uint32 update_rate_hz_ = kDefaultUpdateRate;
+
+  /// The amount of time that has elapsed since the last game logic update, in
+  /// nanoseconds multiplied by `update_rate_hz_`. Keeping the lag in these
+  /// units lets it be tracked exactly, since one update is always exactly
+  /// `SDL_NS_PER_SECOND` of scaled lag no matter the update rate.
+  ///
+  /// This only exceeds one update when catching up in slow motion.
+  Uint64 scaled_lag_ = 0;
+
+  /// What to do when more updates are owed than `max_updates_per_frame_`.
+  CatchUpPolicy catch_up_policy_ = CatchUpPolicy::Clamp;
+
+  /// The maximum number of `on_update` calls made in one frame.
+  Uint64 max_updates_per_frame_ = kDefaultMaxUpdatesPerFrame;
+
+  /// Counters describing how the fixed timestep loop has run.
+  LoopStats loop_stats_;
 
-  /// The amount of time that has elapsed since the last game logic update.
-  /// This should never exceed `kMsPerUpdate`.
-  Uint64 lag_time_ms_ = 0;
+  /// Input received since the last frame.
+  InputQueue input_queue_;
 };
\ No newline at end of file
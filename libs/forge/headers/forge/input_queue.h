@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+/// The kind of input that produced a `PointerEvent`.
+enum class PointerEventType {
+  /// A mouse button was released inside the main render window.
+  MouseClick,
+  /// A finger started touching the main render window.
+  TouchDown,
+};
+
+/// A click or touch at a location in the main render window, measured in
+/// render pixels from the top left corner.
+struct PointerEvent {
+  PointerEventType type = PointerEventType::MouseClick;
+  int x = 0;
+  int y = 0;
+};
+
+/// A new size for the main render window, in pixels.
+struct ResizeEvent {
+  int width = 0;
+  int height = 0;
+};
+
+/// Buffers input events received between frames so that a game can handle all
+/// of them at once, rather than paying for a virtual call and a round of hit
+/// testing per event.
+///
+/// Clicks and touches are kept in the order they arrived. Resizes are
+/// coalesced, so only the last size received before the frame is reported.
+///
+/// The queue reserves space up front and reuses it every frame, so buffering
+/// events does not allocate unless a frame receives more than `capacity`
+/// pointer events.
+class InputQueue {
+public:
+  /// The default number of pointer events reserved per frame.
+  static constexpr size_t kDefaultCapacity = 256;
+
+  /// Constructor.
+  ///
+  /// @param capacity Number of pointer events to reserve space for.
+  explicit InputQueue(size_t capacity = kDefaultCapacity) {
+    pointer_events_.reserve(capacity);
+  }
+
+  /// Add a click or touch to the end of the queue.
+  void push_pointer(PointerEventType type, int x, int y) {
+    pointer_events_.push_back(PointerEvent{.type = type, .x = x, .y = y});
+  }
+
+  /// Record a resize, replacing any earlier resize since the last `clear`.
+  void push_resize(int width, int height) {
+    pending_resize_ = ResizeEvent{.width = width, .height = height};
+  }
+
+  /// Get every click and touch since the last `clear`, oldest first.
+  std::span<const PointerEvent> pointer_events() const {
+    return pointer_events_;
+  }
+
+  /// Get the last resize since the last `clear`, if there was one.
+  const std::optional<ResizeEvent>& pending_resize() const {
+    return pending_resize_;
+  }
+
+  /// Check if no events have been queued since the last `clear`.
+  bool empty() const {
+    return pointer_events_.empty() && !pending_resize_.has_value();
+  }
+
+  /// Remove every queued event while keeping the reserved space.
+  void clear() {
+    pointer_events_.clear();
+    pending_resize_.reset();
+  }
+
+private:
+  std::vector<PointerEvent> pointer_events_;
+  std::optional<ResizeEvent> pending_resize_;
+};
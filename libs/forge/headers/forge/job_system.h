@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// A unit of work run by a `JobSystem`.
+using Job = std::function<void()>;
+
+/// Counts the jobs in a group that have not finished yet. Wait for a group with
+/// `JobSystem::wait`, or start more work once it finishes with
+/// `JobSystem::run_after`.
+///
+/// A counter can be reused once it reaches zero. Only destroy a counter after
+/// `JobSystem::wait` has returned for it, since the last job in the group may
+/// still be using it when `done` first returns true.
+class JobCounter {
+public:
+  JobCounter() = default;
+
+  JobCounter(const JobCounter&) = delete;
+  JobCounter& operator=(const JobCounter&) = delete;
+
+  /// Check if every job in the group has finished.
+  bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+  friend class JobSystem;
+
+  struct Continuation {
+    Job job;
+    JobCounter* counter = nullptr;
+  };
+
+  std::atomic<uint32_t> pending_{0};
+  std::mutex continuations_mutex_;
+  std::vector<Continuation> continuations_;
+};
+
+/// Runs jobs on a pool of worker threads using work stealing.
+///
+/// Every worker has its own double ended queue of jobs. A worker pushes and
+/// pops jobs at the back of its own queue, which keeps recently created (and
+/// cache warm) work on the same thread, and steals from the front of other
+/// queues when its own is empty. Threads that are not workers, such as the main
+/// thread, submit to a shared queue that workers also steal from.
+///
+/// Waiting never blocks: `wait` runs queued jobs on the calling thread until
+/// the counter reaches zero, so jobs may themselves start and wait on other
+/// jobs, and a system with no workers still makes progress.
+///
+/// # Example
+/// ```
+/// jobs.parallel_for(0, count, 1024, [&](size_t begin, size_t end) {
+///   for (size_t i = begin; i < end; ++i) {
+///     update(i);
+///   }
+/// });
+/// ```
+class JobSystem {
+public:
+  /// Constructor.
+  ///
+  /// @param worker_count Number of worker threads to start. Zero starts one
+  ///                     fewer than the number of hardware threads, leaving a
+  ///                     core for the thread that submits and waits on jobs.
+  explicit JobSystem(size_t worker_count = 0);
+
+  /// Destructor. Waits for running jobs to finish and discards any jobs that
+  /// have not started.
+  ~JobSystem();
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  /// Get the number of worker threads.
+  size_t worker_count() const { return workers_.size(); }
+
+  /// Queue a job to run on any thread.
+  ///
+  /// @param counter Incremented now and decremented when the job finishes, or
+  ///                null if the job does not belong to a group.
+  void run(Job job, JobCounter* counter = nullptr);
+
+  /// Queue a job to run once every job counted by `dependency` has finished.
+  /// The job is queued immediately if `dependency` is already done.
+  ///
+  /// @param counter Incremented now and decremented when the job finishes, or
+  ///                null if the job does not belong to a group.
+  void run_after(
+      JobCounter& dependency,
+      Job job,
+      JobCounter* counter = nullptr);
+
+  /// Run queued jobs on the calling thread until `counter` reaches zero.
+  void wait(JobCounter& counter);
+
+  /// Split `[begin, end)` into chunks of at most `grain_size` indices and call
+  /// `body(chunk_begin, chunk_end)` for each chunk in parallel. Returns once
+  /// every chunk has finished, and runs chunks on the calling thread while it
+  /// waits.
+  ///
+  /// @param grain_size Largest chunk size. Zero picks a size that gives every
+  ///                   thread a few chunks.
+  template<typename Func>
+  void parallel_for(size_t begin, size_t end, size_t grain_size, Func&& body);
+
+private:
+  /// Index of the queue shared by threads that are not workers.
+  size_t shared_queue_index() const { return queues_.size() - 1; }
+
+  /// A worker's queue of jobs.
+  struct alignas(64) JobQueue {
+    std::mutex mutex;
+    std::deque<std::pair<Job, JobCounter*>> jobs;
+  };
+
+  void worker_main(size_t worker_index);
+  void push(Job job, JobCounter* counter);
+  bool try_run_one(size_t queue_index);
+  void finish(JobCounter* counter);
+
+private:
+  std::vector<std::unique_ptr<JobQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  /// Number of jobs waiting in every queue, used to put idle workers to sleep.
+  std::atomic<size_t> queued_count_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  bool stopping_ = false;
+};
+
+template<typename Func>
+void JobSystem::parallel_for(
+    size_t begin,
+    size_t end,
+    size_t grain_size,
+    Func&& body) {
+  if (begin >= end) {
+    return;
+  }
+
+  const auto count = end - begin;
+
+  if (grain_size == 0) {
+    constexpr size_t kChunksPerThread = 4;
+    const auto chunk_count = (worker_count() + 1) * kChunksPerThread;
+    grain_size = std::max<size_t>((count + chunk_count - 1) / chunk_count, 1);
+  }
+
+  // Run small ranges inline rather than paying to queue a single chunk.
+  if (count <= grain_size) {
+    body(begin, end);
+    return;
+  }
+
+  JobCounter counter;
+
+  for (auto chunk_begin = begin; chunk_begin < end; chunk_begin += grain_size) {
+    const auto chunk_end = std::min(end, chunk_begin + grain_size);
+    run([&body, chunk_begin, chunk_end] { body(chunk_begin, chunk_end); },
+        &counter);
+  }
+
+  wait(counter);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Log levels used by `FORGE_MIN_LOG_LEVEL`.
+#define FORGE_LOG_LEVEL_DEBUG 1
+#define FORGE_LOG_LEVEL_INFO 2
+#define FORGE_LOG_LEVEL_WARN 3
+#define FORGE_LOG_LEVEL_ERROR 4
+
+// Log calls below this level are removed at compile time, including the
+// evaluation of their arguments. Debug logging is removed from release builds
+// unless the build defines a different level.
+#ifndef FORGE_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define FORGE_MIN_LOG_LEVEL FORGE_LOG_LEVEL_INFO
+#else
+#define FORGE_MIN_LOG_LEVEL FORGE_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+/// Longest message that `forge_log` will write, including the terminating null.
+/// Longer messages are truncated.
+constexpr size_t kMaxLogMessageLength = 256;
+
+/// Number of messages the asynchronous log can hold before new messages are
+/// dropped.
+constexpr size_t kLogQueueCapacity = 1024;
+
+/// Writes a printf style message to the log. Prefer the `FORGE_LOG_*` macros,
+/// which remove messages below `FORGE_MIN_LOG_LEVEL` at compile time.
+///
+/// While asynchronous logging is running the message is formatted on the
+/// calling thread into a lock-free queue, and a background thread passes it to
+/// `SDL_LogMessage`. Otherwise the message is passed to `SDL_LogMessage`
+/// immediately.
+///
+/// Safe to call from any thread.
+void forge_log(
+    int category,
+    SDL_LogPriority priority,
+    SDL_PRINTF_FORMAT_STRING const char* format,
+    ...) SDL_PRINTF_VARARG_FUNC(3);
+
+/// Starts the background thread that writes queued log messages, so that
+/// logging no longer waits on the console or log file. `Game` starts
+/// asynchronous logging when it is initialized.
+void start_async_logging();
+
+/// Writes every queued message and stops the background thread. Messages
+/// logged afterwards are written immediately.
+void stop_async_logging();
+
+/// Get the number of messages dropped because the asynchronous log was full.
+uint64_t log_dropped_count();
+
+#if FORGE_MIN_LOG_LEVEL <= FORGE_LOG_LEVEL_DEBUG
+#define FORGE_LOG_DEBUG(category, ...)                                         \
+  forge_log((category), SDL_LOG_PRIORITY_DEBUG, __VA_ARGS__)
+#else
+#define FORGE_LOG_DEBUG(category, ...) ((void)0)
+#endif
+
+#if FORGE_MIN_LOG_LEVEL <= FORGE_LOG_LEVEL_INFO
+#define FORGE_LOG_INFO(category, ...)                                          \
+  forge_log((category), SDL_LOG_PRIORITY_INFO, __VA_ARGS__)
+#else
+#define FORGE_LOG_INFO(category, ...) ((void)0)
+#endif
+
+#if FORGE_MIN_LOG_LEVEL <= FORGE_LOG_LEVEL_WARN
+#define FORGE_LOG_WARN(category, ...)                                          \
+  forge_log((category), SDL_LOG_PRIORITY_WARN, __VA_ARGS__)
+#else
+#define FORGE_LOG_WARN(category, ...) ((void)0)
+#endif
+
+#if FORGE_MIN_LOG_LEVEL <= FORGE_LOG_LEVEL_ERROR
+#define FORGE_LOG_ERROR(category, ...)                                         \
+  forge_log((category), SDL_LOG_PRIORITY_ERROR, __VA_ARGS__)
+#else
+#define FORGE_LOG_ERROR(category, ...) ((void)0)
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <forge/content.h>
+
+#include <cstddef>
+#include <vector>
+
+/// Halves an image's width and height by averaging each 2x2 block of pixels
+/// (a box filter). When a dimension is odd the last row or column is dropped,
+/// and a dimension of one stays one.
+///
+/// The pixels are allocated the same way `stb_image` allocates decoded images,
+/// so the result can be used anywhere a `decode_image` result can.
+///
+/// @returns The half sized image, or an image with null `pixels` if `image` is
+///          empty.
+DecodedImage downsample_image(const DecodedImage& image);
+
+/// Get the index of the smallest mip level that is at least as large as the
+/// destination on both axes, so a sprite is never magnified and is minified by
+/// less than half. Level `n` is `base_width >> n` by `base_height >> n`, with
+/// neither dimension dropping below one.
+///
+/// @param level_count Number of levels available, which must be at least one.
+size_t mip_level_for(
+    int base_width,
+    int base_height,
+    size_t level_count,
+    float dest_width,
+    float dest_height);
+
+/// An image and successively half sized copies of it, built with
+/// `downsample_image`.
+///
+/// Drawing a large image into a much smaller rectangle makes the renderer read
+/// far more pixels than it writes, and nearest or linear filtering still
+/// aliases. Drawing from the level picked by `level_for` instead keeps the
+/// minification under 2x.
+///
+/// # Example
+/// ```
+/// MipChain mips(decode_image("content/bubble.png"), 32);
+/// const auto& image = mips.level(mips.level_for(64.0f, 64.0f));
+/// ```
+class MipChain {
+public:
+  MipChain() = default;
+
+  /// Constructor. Builds levels until the next level would be smaller than
+  /// `min_size` on either axis.
+  ///
+  /// @param base The full size image, which becomes level zero.
+  /// @param min_size The smallest width or height to generate.
+  explicit MipChain(DecodedImage base, int min_size = 1);
+
+  /// Get the number of levels, including the full size image. Zero if the base
+  /// image was empty.
+  size_t level_count() const { return levels_.size(); }
+
+  /// Get a level, where zero is the full size image.
+  const DecodedImage& level(size_t index) const { return levels_[index]; }
+
+  /// Get the smallest level at least as large as the destination size. See
+  /// `mip_level_for`.
+  size_t level_for(float dest_width, float dest_height) const;
+
+private:
+  std::vector<DecodedImage> levels_;
+};
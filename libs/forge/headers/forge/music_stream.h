@@ -0,0 +1,69 @@
+#pragma once
+
+#include <forge/content.h>
+
+#include <SDL3/SDL_audio.h>
+
+#include <atomic>
+#include <memory>
+#include <span>
+#include <string_view>
+
+struct stb_vorbis;
+
+/// Decodes a .ogg audio file in small blocks as it is played, rather than
+/// decoding the entire file up front like `load_ogg`.
+///
+/// Only the compressed file is kept in memory (or mapped from the content
+/// archive), so long music tracks cost a fraction of the memory of fully
+/// decoded PCM and start playing without waiting for the whole file to decode.
+///
+/// Samples are produced as interleaved F32 at the file's own sample rate and
+/// channel count, see `spec`. `AudioManager::play_music` feeds a music stream
+/// into an `SDL_AudioStream` that converts it for the audio device.
+///
+/// `read` and `rewind` are not thread safe, and are normally only called from
+/// the audio thread while the stream is playing.
+class MusicStream {
+public:
+  /// Opens a .ogg audio file from the game's content directory for streaming.
+  ///
+  /// @param filename Path to the file relative to the game's content root.
+  /// @param loop True to restart from the beginning when the end is reached.
+  /// @returns The music stream, or null if the file could not be opened.
+  static std::unique_ptr<MusicStream>
+      open(std::string_view filename, bool loop);
+
+  /// Destructor.
+  ~MusicStream();
+
+  MusicStream(const MusicStream&) = delete;
+  MusicStream& operator=(const MusicStream&) = delete;
+
+  /// Decodes the next block of samples.
+  ///
+  /// @param samples Buffer that receives interleaved samples. Only whole
+  ///                frames are written.
+  /// @returns The number of frames written, which is less than requested only
+  ///          when the end of a non-looping stream is reached.
+  size_t read(std::span<float> samples);
+
+  /// Restart decoding from the beginning of the file.
+  void rewind();
+
+  /// Get the format of the samples returned by `read`.
+  const SDL_AudioSpec& spec() const { return spec_; }
+
+  /// True if a non-looping stream has been read to the end.
+  bool finished() const { return finished_.load(std::memory_order_relaxed); }
+
+private:
+  MusicStream(ContentBytes file, stb_vorbis* vorbis, bool loop);
+
+private:
+  ContentBytes file_;
+  stb_vorbis* vorbis_ = nullptr;
+  SDL_AudioSpec spec_ = {};
+  bool loop_ = false;
+  std::atomic<bool> finished_ = false;
+};
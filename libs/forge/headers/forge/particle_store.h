@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class JobSystem;
+
+/// Initial state of a particle when it is spawned into a `ParticleStore`.
+struct ParticleDesc {
+  float x = 0.0f;
+  float y = 0.0f;
+  float size = 64.0f;
+  float speed = 100.0f;
+  float wobble_amplitude = 0.0f;
+  float wobble_frequency = 1.0f;
+  float wobble_phase = 0.0f;
+};
+
+/// Structure-of-arrays storage for particles that float upwards while wobbling
+/// side to side.
+///
+/// Each particle attribute is kept in its own contiguous float array so the
+/// update kernel can process several particles per SIMD instruction. Removal
+/// swaps the last particle into the removed slot, which keeps the live range
+/// dense but means particle indices are not stable across removals.
+///
+/// Positions are double buffered: `integrate` keeps each particle's position
+/// from before the step, so that rendering can blend between the last two
+/// simulated positions with `interpolate_positions` and stay smooth when the
+/// simulation runs slower than the display.
+class ParticleStore {
+public:
+  /// Reserve storage for at least `capacity` particles.
+  void reserve(size_t capacity);
+
+  /// Remove all particles.
+  void clear();
+
+  /// Get the number of live particles.
+  size_t size() const { return x_.size(); }
+
+  /// Check if there are no live particles.
+  bool empty() const { return x_.empty(); }
+
+  /// Add a new particle to the end of the store.
+  ///
+  /// @returns Index of the new particle.
+  size_t spawn(const ParticleDesc& desc);
+
+  /// Remove the particle at `index` by moving the last particle into its slot.
+  void swap_remove(size_t index);
+
+  /// Advance every particle by one time step and remove particles that have
+  /// floated past `despawn_y`. Movement and the despawn test run as a single
+  /// fused pass over the particle arrays. Each particle's position before the
+  /// step becomes its previous position.
+  ///
+  /// @param delta_s Length of the time step in seconds.
+  /// @param time_s Total simulation time in seconds, used for the wobble.
+  /// @param despawn_y Particles are removed once `y >= despawn_y + size`.
+  /// @returns The number of particles that were removed.
+  size_t integrate(float delta_s, float time_s, float despawn_y);
+
+  /// Same as `integrate`, but moves particles on every thread of `jobs` in
+  /// chunks of `kParallelChunkSize`. Stores with no more than one chunk of
+  /// particles are integrated on the calling thread.
+  size_t integrate(
+      float delta_s,
+      float time_s,
+      float despawn_y,
+      JobSystem& jobs);
+
+  /// Number of particles moved by each job in the parallel `integrate`. The
+  /// bubble game has far fewer particles than this, so it always integrates on
+  /// the calling thread. `BM_BubbleIntegrateParallel` covers larger stores.
+  static constexpr size_t kParallelChunkSize = 16384;
+
+  std::span<const float> x_positions() const { return x_; }
+  std::span<const float> y_positions() const { return y_; }
+  std::span<const float> sizes() const { return size_; }
+  std::span<const float> previous_x_positions() const { return previous_x_; }
+  std::span<const float> previous_y_positions() const { return previous_y_; }
+
+  /// Blend every particle's previous and current position and write the
+  /// results to `out_x` and `out_y`, which must hold at least `size()` floats.
+  ///
+  /// @param alpha How far to blend from the previous position (0) to the
+  ///              current position (1), usually the `extrapolation` value
+  ///              passed to `Game::on_render`.
+  void interpolate_positions(
+      float alpha,
+      std::span<float> out_x,
+      std::span<float> out_y) const;
+
+private:
+  /// Move the particles in `[begin, end)` and append the index of every
+  /// particle that should despawn to `dead_indices` in increasing order.
+  void integrate_range(
+      size_t begin,
+      size_t end,
+      float delta_s,
+      float time_s,
+      float despawn_y,
+      std::vector<uint32_t>& dead_indices);
+
+  /// Remove every particle listed in `dead_indices_`.
+  void remove_dead();
+
+private:
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> previous_x_;
+  std::vector<float> previous_y_;
+  std::vector<float> size_;
+  std::vector<float> speed_;
+  std::vector<float> wobble_amplitude_;
+  std::vector<float> wobble_frequency_;
+  std::vector<float> wobble_phase_;
+
+  /// Scratch list of particles found dead by `integrate`, kept as a member to
+  /// avoid allocating every update.
+  std::vector<uint32_t> dead_indices_;
+
+  /// Per chunk scratch lists used by the parallel `integrate`.
+  std::vector<std::vector<uint32_t>> chunk_dead_indices_;
+};
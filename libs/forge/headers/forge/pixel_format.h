@@ -0,0 +1,23 @@
+#pragma once
+
+#include <SDL3/SDL_pixels.h>
+
+#include <span>
+
+struct SDL_Renderer;
+
+/// Get the 32-bit RGBA layout that the renderer can create textures in without
+/// converting pixels, preferring `SDL_PIXELFORMAT_RGBA32` (the byte order
+/// `decode_image` produces) over `SDL_PIXELFORMAT_BGRA32`.
+///
+/// Returns `SDL_PIXELFORMAT_RGBA32` if the renderer supports neither, in which
+/// case SDL converts the pixels itself when a texture is updated.
+SDL_PixelFormat native_rgba_format(SDL_Renderer* renderer);
+
+/// Swaps the red and blue channels of tightly packed 8-bit RGBA pixels in
+/// place, which converts `SDL_PIXELFORMAT_RGBA32` to `SDL_PIXELFORMAT_BGRA32`
+/// and back.
+///
+/// @param pixels Pixel bytes, four per pixel. Any trailing partial pixel is
+///               left unchanged.
+void swap_red_blue(std::span<unsigned char> pixels);
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// A 2D uniform grid that hashes square cells into buckets of entity ids, so
+/// that point and circle queries only visit entities near the query instead of
+/// every entity in the world.
+///
+/// Entities are circles identified by a caller chosen `uint32_t` id (typically
+/// an index into the caller's own storage). Each entity is stored in every
+/// cell its bounding box overlaps. For best results choose a cell size at least
+/// as large as the biggest entity's diameter.
+///
+/// The grid is filled in two phases. Call `insert` for every entity and then
+/// `build` to pack the entities into buckets. After that the grid can be
+/// queried and patched with `remove` and `replace_id` without a rebuild.
+///
+/// # Example
+/// ```
+/// SpatialGrid grid{128.0f};
+///
+/// for (uint32_t i = 0; i < count; ++i) {
+///   grid.insert(i, x[i], y[i], radius[i]);
+/// }
+///
+/// grid.build();
+/// grid.query_point(mouse_x, mouse_y, [&](uint32_t id) {
+///   // ... exact hit test against entity `id`.
+///   return true; // keep searching.
+/// });
+/// ```
+class SpatialGrid {
+public:
+  /// Constructor.
+  ///
+  /// @param cell_size Width and height of a grid cell in world units.
+  explicit SpatialGrid(float cell_size);
+
+  /// Remove all entities, including any inserted since the last build.
+  void clear();
+
+  /// Stage an entity for the next call to `build`.
+  void insert(uint32_t id, float x, float y, float radius);
+
+  /// Pack every staged entity into the grid's buckets, replacing whatever the
+  /// grid held before. Bucket storage is reused between builds.
+  void build();
+
+  /// Remove an entity from the grid. The position and radius must be the same
+  /// values used when the entity was inserted.
+  ///
+  /// @returns True if the entity was found, false otherwise.
+  bool remove(uint32_t id, float x, float y, float radius);
+
+  /// Change the id of an entity already in the grid. This is useful when the
+  /// caller swap-removes entities, which moves an entity to a new index. The
+  /// position and radius must be the same values used when the entity was
+  /// inserted.
+  ///
+  /// @returns True if the entity was found, false otherwise.
+  bool replace_id(
+      uint32_t old_id,
+      uint32_t new_id,
+      float x,
+      float y,
+      float radius);
+
+  /// Call `visit(id)` for every entity stored in the cell containing the
+  /// point. Visited entities are candidates that still need an exact hit test.
+  /// Return false from `visit` to stop the query early.
+  template<typename Func>
+  void query_point(float x, float y, Func&& visit) const;
+
+  /// Call `visit(id)` for every entity stored in a cell overlapping the circle.
+  /// An entity that spans several cells can be visited more than once. Return
+  /// false from `visit` to stop the query early.
+  template<typename Func>
+  void query_circle(float x, float y, float radius, Func&& visit) const;
+
+  /// Get the size of a grid cell in world units.
+  float cell_size() const { return cell_size_; }
+
+private:
+  /// Inclusive range of cells covered by an entity's bounding box.
+  struct CellRange {
+    int32_t min_x = 0;
+    int32_t min_y = 0;
+    int32_t max_x = 0;
+    int32_t max_y = 0;
+  };
+
+  CellRange cells_for(float x, float y, float radius) const;
+  uint32_t bucket_for(int32_t cell_x, int32_t cell_y) const;
+
+  /// Call `visit(bucket)` once for every unique bucket covered by `cells`.
+  template<typename Func>
+  void for_each_unique_bucket(const CellRange& cells, Func&& visit) const;
+
+private:
+  float cell_size_ = 0.0f;
+  float inverse_cell_size_ = 0.0f;
+
+  /// Entities waiting for the next `build`.
+  struct StagedEntity {
+    uint32_t id = 0;
+    CellRange cells;
+  };
+
+  std::vector<StagedEntity> staged_;
+
+  /// Scratch list of (bucket, id) pairs used by `build`.
+  std::vector<std::pair<uint32_t, uint32_t>> bucket_entries_;
+
+  /// Buckets are packed into `ids_`, with bucket `b` starting at
+  /// `bucket_start_[b]` and holding `bucket_size_[b]` live entries.
+  std::vector<uint32_t> bucket_start_;
+  std::vector<uint32_t> bucket_size_;
+  std::vector<uint32_t> ids_;
+  uint32_t bucket_mask_ = 0;
+};
+
+template<typename Func>
+void SpatialGrid::for_each_unique_bucket(
+    const CellRange& cells,
+    Func&& visit) const {
+  // Entities rarely cover more than a few cells, so track the buckets already
+  // visited in a small fixed array. Past that a bucket may be visited twice,
+  // but always in the same way for the same cells, so `build`, `remove` and
+  // `replace_id` stay consistent with each other.
+  constexpr size_t kMaxTracked = 16;
+  uint32_t visited[kMaxTracked];
+  size_t visited_count = 0;
+
+  for (int32_t cell_y = cells.min_y; cell_y <= cells.max_y; ++cell_y) {
+    for (int32_t cell_x = cells.min_x; cell_x <= cells.max_x; ++cell_x) {
+      const auto bucket = bucket_for(cell_x, cell_y);
+      bool seen = false;
+
+      for (size_t i = 0; i < visited_count; ++i) {
+        seen = seen || visited[i] == bucket;
+      }
+
+      if (seen) {
+        continue;
+      }
+
+      if (visited_count < kMaxTracked) {
+        visited[visited_count++] = bucket;
+      }
+
+      if (!visit(bucket)) {
+        return;
+      }
+    }
+  }
+}
+
+template<typename Func>
+void SpatialGrid::query_point(float x, float y, Func&& visit) const {
+  query_circle(x, y, 0.0f, visit);
+}
+
+template<typename Func>
+void SpatialGrid::query_circle(
+    float x,
+    float y,
+    float radius,
+    Func&& visit) const {
+  if (bucket_start_.empty()) {
+    return;
+  }
+
+  for_each_unique_bucket(cells_for(x, y, radius), [&](uint32_t bucket) {
+    const auto start = bucket_start_[bucket];
+    const auto end = start + bucket_size_[bucket];
+
+    for (auto i = start; i < end; ++i) {
+      if (!visit(ids_[i])) {
+        return false;
+      }
+    }
+
+    return true;
+  });
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <vector>
+
+/// Collects textured quads and submits them to the renderer with one
+/// `SDL_RenderGeometry` call per texture rather than one `SDL_RenderTexture`
+/// call per sprite.
+///
+/// Sprites are grouped by texture, which means that sprites drawn with
+/// different textures are not guaranteed to be layered in the order they were
+/// queued. Sprites sharing a texture are always drawn in submission order.
+///
+/// # Example
+/// ```
+/// SpriteBatch batch;
+///
+/// for (const auto& sprite : sprites) {
+///   batch.draw(texture, sprite.src_rect, sprite.dest_rect);
+/// }
+///
+/// batch.flush(renderer);
+/// ```
+class SpriteBatch {
+public:
+  /// Queue a textured quad for drawing.
+  ///
+  /// @param texture The texture to sample from.
+  /// @param src_rect Area of the texture to draw, in texture pixels.
+  /// @param dest_rect Area of the render target to draw into.
+  /// @param color Color and alpha modulation applied to the sprite.
+  void draw(
+      SDL_Texture* texture,
+      const SDL_FRect& src_rect,
+      const SDL_FRect& dest_rect,
+      SDL_FColor color = {1.0f, 1.0f, 1.0f, 1.0f});
+
+  /// Submit all queued sprites to the renderer and reset the batch. Buffers are
+  /// kept between flushes so a steady state frame does not allocate.
+  ///
+  /// @returns True if every texture batch was rendered, false otherwise.
+  bool flush(SDL_Renderer* renderer);
+
+  /// Remove all queued sprites without rendering them.
+  void clear();
+
+  /// Get the number of sprites waiting to be flushed.
+  size_t sprite_count() const;
+
+private:
+  /// Vertex and index buffers for all sprites sharing a texture.
+  struct TextureBatch {
+    SDL_Texture* texture = nullptr;
+    float inverse_width = 0.0f;
+    float inverse_height = 0.0f;
+    std::vector<SDL_Vertex> vertices = {};
+    std::vector<int> indices = {};
+  };
+
+  TextureBatch& batch_for(SDL_Texture* texture);
+
+private:
+  std::vector<TextureBatch> batches_;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/// Size of a cache line on the platforms forge targets. Used to keep data
+/// written by different threads on separate cache lines.
+constexpr size_t kCacheLineSize = 64;
+
+/// A fixed capacity, lock-free, single-producer single-consumer queue.
+///
+/// Exactly one thread may push and exactly one (possibly different) thread may
+/// pop at any time. Both operations are wait-free: they never block, never
+/// allocate and fail immediately instead when the queue is full or empty. This
+/// makes the queue suitable for passing messages to a real-time thread such as
+/// the audio callback.
+///
+/// The producer and consumer positions live on separate cache lines, and each
+/// side caches the other side's position so that the shared atomics are only
+/// read when the cached value says the queue looks full or empty.
+///
+/// # Example
+/// ```
+/// SpscQueue<Command, 256> commands;
+///
+/// // Producer thread.
+/// commands.try_push(Command{...});
+///
+/// // Consumer thread.
+/// Command command;
+///
+/// while (commands.try_pop(command)) {
+///   // ... handle command.
+/// }
+/// ```
+template<typename T, size_t Capacity>
+class SpscQueue {
+  static_assert(
+      Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+      "capacity must be a power of two");
+  static_assert(
+      std::is_nothrow_copy_assignable_v<T> ||
+          std::is_nothrow_move_assignable_v<T>,
+      "queued values must be assignable without throwing");
+
+public:
+  /// Add a value to the back of the queue. Only call from the producer thread.
+  ///
+  /// @returns True if the value was added, false if the queue is full.
+  bool try_push(const T& value) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+
+    if (tail - cached_head_ == Capacity) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+
+      if (tail - cached_head_ == Capacity) {
+        return false;
+      }
+    }
+
+    slots_[tail & kMask] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /// Remove the value at the front of the queue. Only call from the consumer
+  /// thread.
+  ///
+  /// @returns True if a value was removed into `value`, false if the queue is
+  ///          empty.
+  bool try_pop(T& value) {
+    const auto head = head_.load(std::memory_order_relaxed);
+
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+
+    value = std::move(slots_[head & kMask]);
+    head_.store(head + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /// Get the number of queued values. The result is only a snapshot when
+  /// called while the other thread is using the queue.
+  size_t size() const {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+  /// True if the queue held no values when checked.
+  bool empty() const { return size() == 0; }
+
+  /// Get the maximum number of values the queue can hold.
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  static constexpr size_t kMask = Capacity - 1;
+
+  /// Position of the next value to pop, written by the consumer.
+  alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+  /// The consumer's last seen value of `tail_`.
+  size_t cached_tail_ = 0;
+
+  /// Position of the next value to push, written by the producer.
+  alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+  /// The producer's last seen value of `head_`.
+  size_t cached_head_ = 0;
+
+  alignas(kCacheLineSize) std::array<T, Capacity> slots_{};
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+
+/// A read-only view of a file's contents that is memory mapped when the
+/// platform allows it.
+///
+/// Mapping avoids copying the file into a heap buffer, and only the pages that
+/// are actually touched are read from disk. When the file cannot be mapped
+/// (for example Android assets stored inside the APK) the whole file is read
+/// into memory with SDL instead, so callers do not need a separate code path.
+///
+/// # Example
+/// ```
+/// auto file = MappedFile::open(full_path);
+///
+/// if (file != nullptr) {
+///   std::span<const unsigned char> bytes = file->bytes();
+/// }
+/// ```
+class MappedFile {
+public:
+  /// Opens a file for reading.
+  ///
+  /// @param path Full path to the file.
+  /// @returns The opened file, or null if it could not be opened.
+  static std::unique_ptr<MappedFile> open(const std::string& path);
+
+  /// Destructor. Unmaps or frees the file's contents.
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// Get the contents of the file. The view is valid for the lifetime of this
+  /// object.
+  std::span<const unsigned char> bytes() const { return {data_, size_}; }
+
+  /// Get the size of the file in bytes.
+  size_t size() const { return size_; }
+
+  /// True if the file is memory mapped, false if it was read into memory.
+  bool is_mapped() const { return is_mapped_; }
+
+private:
+  MappedFile() = default;
+
+  bool map(const std::string& path);
+  bool read(const std::string& path);
+
+private:
+  const unsigned char* data_ = nullptr;
+  size_t size_ = 0;
+  bool is_mapped_ = false;
+
+#if defined(_WIN32)
+  /// File mapping object that backs `data_` when the file is mapped.
+  void* mapping_handle_ = nullptr;
+#endif
+};
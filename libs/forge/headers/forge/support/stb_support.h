@@ -1,6 +1,12 @@
 #pragma once
 #include <stb/stb_image.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct SDL_IOStream;
+
 /// Returns a `stbi_io_callbacks` struct that will use the SDL2 IO Stream API to
 /// handle file i/o when loading images.
 ///
@@ -23,6 +29,71 @@
 /// ```
 stbi_io_callbacks create_stbi_sdl2_io_callbacks();
 
+/// Reads an `SDL_IOStream` through an in-memory buffer, so that many small
+/// reads cost one large read from the stream.
+///
+/// `stb_image` refills its own 128 byte buffer with a separate read callback
+/// for each refill, and every read passed straight to `SDL_ReadIO` is a system
+/// call (or a network round trip on network file systems). Reading in large
+/// blocks cuts those calls by orders of magnitude. Skips that land inside the
+/// buffered block only move the read position.
+///
+/// The reader does not own the stream, and assumes nothing else reads from or
+/// seeks the stream while the reader is in use.
+class BufferedSdlReader {
+public:
+  /// Default number of bytes read from the stream at a time.
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+  /// Constructor.
+  ///
+  /// @param stream Stream to read from, which must outlive the reader.
+  /// @param block_size Number of bytes to read from the stream at a time.
+  explicit BufferedSdlReader(
+      SDL_IOStream* stream,
+      size_t block_size = kDefaultBlockSize);
+
+  /// Reads up to `size` bytes into `data`.
+  ///
+  /// @returns The number of bytes read, which is less than `size` only at the
+  ///          end of the stream or if the stream fails.
+  size_t read(void* data, size_t size);
+
+  /// Moves the read position by `count` bytes, which may be negative.
+  void skip(int64_t count);
+
+  /// True if every byte of the stream has been read.
+  bool eof() const;
+
+private:
+  bool refill();
+
+private:
+  SDL_IOStream* stream_ = nullptr;
+  std::vector<unsigned char> buffer_;
+  /// Index of the next unread byte in `buffer_`.
+  size_t position_ = 0;
+  /// Number of valid bytes in `buffer_`.
+  size_t end_ = 0;
+};
+
+/// Returns a `stbi_io_callbacks` struct that reads through a
+/// `BufferedSdlReader`.
+///
+/// NOTE: You **MUST** pass the pointer to the `BufferedSdlReader` as the user
+/// data when calling functions like `stbi_load_from_callbacks`, not the stream
+/// itself.
+///
+/// # Example:
+/// ```
+/// BufferedSdlReader reader{file_io_stream};
+/// const auto stbio = create_stbi_buffered_io_callbacks();
+///
+/// unsigned char* image_bytes = stbi_load_from_callbacks(
+///     &stbio, &reader, &width, &height, nullptr, STBI_rgb_alpha);
+/// ```
+stbi_io_callbacks create_stbi_buffered_io_callbacks();
+
 /// Functor that frees the image bytes returned by a `stb_image` load function.
 struct StbImageBytesDeleter {
   void operator()(unsigned char* image_bytes) const noexcept;
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <forge/content.h>
+#include <forge/support/sdl_support.h>
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// Packs rectangles into a fixed size area using the skyline bottom-left
+/// heuristic.
+///
+/// The packer tracks the top edge of everything placed so far as a list of
+/// horizontal segments (the skyline), and places each new rectangle where its
+/// top edge ends up lowest. This wastes a little more space than a maxrects
+/// packer but is much faster and needs no per-rectangle bookkeeping, which
+/// suits adding images to an atlas one at a time as they load.
+class SkylinePacker {
+public:
+  /// Constructor.
+  ///
+  /// @param width Width of the area to pack into.
+  /// @param height Height of the area to pack into.
+  SkylinePacker(int width, int height);
+
+  /// Find space for a `width` x `height` rectangle and reserve it.
+  ///
+  /// @returns The rectangle's position, or nothing if it does not fit.
+  std::optional<SDL_Rect> pack(int width, int height);
+
+  /// Release every rectangle.
+  void clear();
+
+  /// Get the width of the area being packed.
+  int width() const { return width_; }
+
+  /// Get the height of the area being packed.
+  int height() const { return height_; }
+
+  /// Get the fraction of the area covered by packed rectangles.
+  float occupancy() const;
+
+private:
+  /// A horizontal segment of the skyline.
+  struct Segment {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+  };
+
+  /// Get the lowest `y` a rectangle `width` wide can be placed at when its left
+  /// edge is at the start of segment `index`, or nothing if it does not fit.
+  std::optional<int> fit(size_t index, int width, int height) const;
+
+private:
+  int width_ = 0;
+  int height_ = 0;
+  int64_t used_area_ = 0;
+  std::vector<Segment> skyline_;
+};
+
+/// Where an image was placed in a `TextureAtlas`.
+struct AtlasRegion {
+  /// Index of the atlas page holding the image.
+  size_t page = 0;
+  /// Area of the page texture covered by the image, in texture pixels.
+  SDL_FRect src_rect{};
+};
+
+/// Packs many images into a few large textures (pages) so that sprites using
+/// different images can still be drawn in a single `SpriteBatch` flush.
+///
+/// Images are copied into the atlas as they are added, and the page textures
+/// are created or updated on the render thread by `upload`. `Game::iterate`
+/// uploads the game's atlas once per frame.
+///
+/// Each image is surrounded by a border of copies of its edge pixels, so
+/// linear filtering at the edge of a sprite never samples a neighbouring image.
+///
+/// # Example
+/// ```
+/// auto region = atlas.add(decode_image("content/foo.png"), "foo");
+/// atlas.upload(renderer);
+///
+/// sprite_batch.draw(
+///     atlas.page_texture(region->page),
+///     region->src_rect,
+///     dest_rect);
+/// ```
+class TextureAtlas {
+public:
+  /// The default width and height of each page in pixels.
+  static constexpr int kDefaultPageSize = 1024;
+
+  /// Number of border pixels added around each image.
+  static constexpr int kPadding = 1;
+
+  /// Constructor.
+  ///
+  /// @param page_size Width and height of each page in pixels. Images larger
+  ///                  than a page (less padding) cannot be added.
+  explicit TextureAtlas(int page_size = kDefaultPageSize);
+
+  TextureAtlas(const TextureAtlas&) = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+  /// Copy an image into the atlas. The page texture is updated by the next
+  /// call to `upload`.
+  ///
+  /// @param name Optional name to look the image up with `find`. Adding a
+  ///             name that is already in the atlas returns the existing
+  ///             region.
+  /// @returns Where the image was placed, or nothing if the image is empty or
+  ///          too large for a page.
+  std::optional<AtlasRegion> add(
+      const DecodedImage& image,
+      std::string_view name = {});
+
+  /// Find an image that was added with a name.
+  std::optional<AtlasRegion> find(std::string_view name) const;
+
+  /// Create textures for new pages and copy images added since the last call
+  /// into them. This must be called on the thread that owns the renderer.
+  ///
+  /// @returns True if every page was updated, false otherwise.
+  bool upload(SDL_Renderer* renderer);
+
+  /// Get the texture for a page, or null if the page has not been uploaded.
+  SDL_Texture* page_texture(size_t page) const {
+    return page < pages_.size() ? pages_[page].texture.get() : nullptr;
+  }
+
+  /// Get the number of pages.
+  size_t page_count() const { return pages_.size(); }
+
+  /// Get the width and height of each page in pixels.
+  int page_size() const { return page_size_; }
+
+  /// Get the number of images waiting for `upload`.
+  size_t pending_upload_count() const { return pending_uploads_.size(); }
+
+private:
+  struct Page {
+    SkylinePacker packer;
+    unique_sdl_texture_ptr texture;
+  };
+
+  /// A padded copy of an image waiting to be copied into its page texture.
+  struct PendingUpload {
+    size_t page = 0;
+    SDL_Rect rect{};
+    std::vector<unsigned char> pixels;
+  };
+
+private:
+  int page_size_ = 0;
+
+  /// Pixel layout of the page textures, chosen by the first `upload`.
+  SDL_PixelFormat page_format_ = SDL_PIXELFORMAT_UNKNOWN;
+
+  std::vector<Page> pages_;
+  std::vector<PendingUpload> pending_uploads_;
+  std::unordered_map<std::string, AtlasRegion> named_regions_;
+};
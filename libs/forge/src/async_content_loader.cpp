@@ -0,0 +1,245 @@
+#include <forge/async_content_loader.h>
+
+#include <forge/content.h>
+#include <forge/content_cache.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+
+AsyncContentLoader::AsyncContentLoader(
+    size_t worker_count,
+    ContentCache* cache)
+    : cache_(cache) {
+  if (worker_count == 0) {
+    worker_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  workers_.reserve(worker_count);
+
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back([this] { worker_main(); });
+  }
+
+  SDL_LogMessage(
+      SDL_LOG_CATEGORY_APPLICATION,
+      SDL_LOG_PRIORITY_DEBUG,
+      "started async content loader with %d worker threads",
+      static_cast<int>(worker_count));
+}
+
+AsyncContentLoader::~AsyncContentLoader() {
+  {
+    std::lock_guard lock(tasks_mutex_);
+    stopping_ = true;
+  }
+
+  tasks_cv_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::future<std::shared_ptr<SDL_Texture>>
+    AsyncContentLoader::load_texture(const std::string_view filename) {
+  std::promise<std::shared_ptr<SDL_Texture>> texture;
+  auto future = texture.get_future();
+
+  if (cache_ != nullptr) {
+    if (auto cached = cache_->find_texture(filename); cached != nullptr) {
+      texture.set_value(std::move(cached));
+      return future;
+    }
+  }
+
+  enqueue(std::packaged_task<void()>{
+      [this,
+       filename = std::string{filename},
+       texture = std::move(texture)]() mutable {
+        auto image = decode_image(filename);
+
+        // Finish immediately if the image failed to decode, otherwise hand it
+        // to the main thread to create the texture.
+        if (image.pixels == nullptr) {
+          pending_count_--;
+          texture.set_value(nullptr);
+          return;
+        }
+
+        std::lock_guard lock(uploads_mutex_);
+        uploads_.push_back(PendingUpload{
+            .filename = std::move(filename),
+            .image = std::move(image),
+            .texture = std::move(texture),
+        });
+      }});
+
+  return future;
+}
+
+std::future<DecodedImage>
+    AsyncContentLoader::load_image(const std::string_view filename) {
+  std::promise<DecodedImage> image;
+  auto future = image.get_future();
+
+  enqueue(std::packaged_task<void()>{
+      [this,
+       filename = std::string{filename},
+       image = std::move(image)]() mutable {
+        auto result = decode_image(filename);
+        pending_count_--;
+        image.set_value(std::move(result));
+      }});
+
+  return future;
+}
+
+std::future<MipChain> AsyncContentLoader::load_mip_chain(
+    const std::string_view filename,
+    int min_size) {
+  std::promise<MipChain> mip_chain;
+  auto future = mip_chain.get_future();
+
+  enqueue(std::packaged_task<void()>{
+      [this,
+       filename = std::string{filename},
+       min_size,
+       mip_chain = std::move(mip_chain)]() mutable {
+        MipChain result(decode_image(filename), min_size);
+        pending_count_--;
+        mip_chain.set_value(std::move(result));
+      }});
+
+  return future;
+}
+
+std::future<std::shared_ptr<const SdlAudioBuffer>>
+    AsyncContentLoader::load_ogg(const std::string_view filename) {
+  return load_audio(filename, [](const std::string& filename) {
+    return ::load_ogg(filename);
+  });
+}
+
+std::future<std::shared_ptr<const SdlAudioBuffer>>
+    AsyncContentLoader::load_wav(const std::string_view filename) {
+  return load_audio(filename, [](const std::string& filename) {
+    return ::load_wav(filename);
+  });
+}
+
+template<typename LoadFunc>
+std::future<std::shared_ptr<const SdlAudioBuffer>>
+    AsyncContentLoader::load_audio(
+        const std::string_view filename,
+        LoadFunc load) {
+  std::promise<std::shared_ptr<const SdlAudioBuffer>> audio_buffer;
+  auto future = audio_buffer.get_future();
+
+  if (cache_ != nullptr) {
+    if (auto cached = cache_->find_audio(filename); cached != nullptr) {
+      audio_buffer.set_value(std::move(cached));
+      return future;
+    }
+  }
+
+  enqueue(std::packaged_task<void()>{
+      [this,
+       filename = std::string{filename},
+       load = std::move(load),
+       audio_buffer = std::move(audio_buffer)]() mutable {
+        auto audio = load(filename);
+
+        // Finish immediately on failure, since there is nothing to cache.
+        if (audio == nullptr) {
+          pending_count_--;
+          audio_buffer.set_value(nullptr);
+          return;
+        }
+
+        std::lock_guard lock(uploads_mutex_);
+        audio_uploads_.push_back(PendingAudio{
+            .filename = std::move(filename),
+            .audio = std::move(audio),
+            .promise = std::move(audio_buffer),
+        });
+      }});
+
+  return future;
+}
+
+size_t AsyncContentLoader::process_uploads(SDL_Renderer* renderer) {
+  // Take the lists of loaded content so that workers are not blocked while
+  // the textures are created.
+  std::vector<PendingUpload> uploads;
+  std::vector<PendingAudio> audio_uploads;
+
+  {
+    std::lock_guard lock(uploads_mutex_);
+    uploads.swap(uploads_);
+    audio_uploads.swap(audio_uploads_);
+  }
+
+  SDL_assert(renderer != nullptr || uploads.empty());
+
+  for (auto& upload : uploads) {
+    auto texture =
+        create_texture(renderer, std::move(upload.image), upload.filename);
+    std::shared_ptr<SDL_Texture> shared_texture;
+
+    if (texture != nullptr && cache_ != nullptr) {
+      shared_texture = cache_->add_texture(upload.filename, std::move(texture));
+    } else {
+      shared_texture = std::move(texture);
+    }
+
+    pending_count_--;
+    upload.texture.set_value(std::move(shared_texture));
+  }
+
+  for (auto& upload : audio_uploads) {
+    std::shared_ptr<const SdlAudioBuffer> audio;
+
+    if (cache_ != nullptr) {
+      audio = cache_->add_audio(upload.filename, std::move(upload.audio));
+    } else {
+      audio = std::move(upload.audio);
+    }
+
+    pending_count_--;
+    upload.promise.set_value(std::move(audio));
+  }
+
+  return uploads.size() + audio_uploads.size();
+}
+
+void AsyncContentLoader::enqueue(std::packaged_task<void()> task) {
+  pending_count_++;
+
+  {
+    std::lock_guard lock(tasks_mutex_);
+    tasks_.push_back(std::move(task));
+  }
+
+  tasks_cv_.notify_one();
+}
+
+void AsyncContentLoader::worker_main() {
+  while (true) {
+    std::packaged_task<void()> task;
+
+    {
+      std::unique_lock lock(tasks_mutex_);
+      tasks_cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+
+      if (stopping_) {
+        return;
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
@@ -4,6 +4,10 @@
 
 #include "../headers/forge/audio_manager.h"
 
+#include <forge/music_stream.h>
+
+#include <algorithm>
+
 AudioManager::AudioManager() {
 #ifdef NDEBUG
   SDL_SetLogPriority(FORGE_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_INFO);
@@ -12,6 +16,12 @@ AudioManager::AudioManager() {
 #endif
 }
 
+AudioManager::~AudioManager() {
+  // Destroy the audio streams before the mixer and music they read from.
+  stop_music();
+  default_audio_stream_.reset();
+}
+
 SDL_AppResult AudioManager::init() {
   // Open the machine's default audio device and begin playback.
   audio_device_id_ =
@@ -68,6 +78,22 @@ SDL_AppResult AudioManager::init() {
     return SDL_APP_FAILURE;
   }
 
+  // Mix sounds on demand whenever the device needs more samples, rather than
+  // queueing whole sounds into the stream.
+  constexpr size_t kMixFrames = 2048;
+  mix_samples_.resize(kMixFrames * DEFAULT_AUDIO_SPEC.channels);
+
+  if (!SDL_SetAudioStreamGetCallback(
+          default_audio_stream_.get(),
+          &AudioManager::mix_stream_callback,
+          this)) {
+    SDL_LogError(
+        FORGE_LOG_CATEGORY_AUDIO,
+        "SDL_SetAudioStreamGetCallback error: %s",
+        SDL_GetError());
+    return SDL_APP_FAILURE;
+  }
+
   if (!SDL_BindAudioStream(audio_device_id_, default_audio_stream_.get())) {
     SDL_LogError(
         FORGE_LOG_CATEGORY_AUDIO,
@@ -80,7 +106,13 @@ SDL_AppResult AudioManager::init() {
   return SDL_APP_CONTINUE;
 }
 
-bool AudioManager::play_once(const SdlAudioBuffer* buffer) const {
+bool AudioManager::play_once(const SdlAudioBuffer* buffer) {
+  return play(buffer) != kInvalidVoiceId;
+}
+
+VoiceId AudioManager::play(
+    const SdlAudioBuffer* buffer,
+    const VoiceParams& params) {
   SDL_assert(buffer != nullptr);
 
   // Refuse to play samples with a different format than the game's default. All
@@ -91,25 +123,239 @@ bool AudioManager::play_once(const SdlAudioBuffer* buffer) const {
 
     SDL_LogError(
         FORGE_LOG_CATEGORY_AUDIO,
-        "unexpected audio spec in call to play_once: format = %x, channels = "
+        "unexpected audio spec in call to play: format = %x, channels = "
         "%d, freq = %d",
         buffer->spec.format,
         buffer->spec.channels,
         buffer->spec.freq);
 
+    return kInvalidVoiceId;
+  }
+
+  // Pick the voice's id now so it can be returned without waiting for the
+  // audio thread to start the voice.
+  const auto voice = mixer_.create_voice_id();
+
+  if (!send(AudioCommand{
+          .type = AudioCommand::Type::Play,
+          .voice = voice,
+          .samples = reinterpret_cast<const float*>(buffer->data),
+          .sample_count = buffer->size_in_bytes / sizeof(float),
+          .params = params,
+      })) {
+    return kInvalidVoiceId;
+  }
+
+  return voice;
+}
+
+void AudioManager::stop(VoiceId voice) {
+  send(AudioCommand{.type = AudioCommand::Type::Stop, .voice = voice});
+}
+
+void AudioManager::set_gain(VoiceId voice, float gain) {
+  send(AudioCommand{
+      .type = AudioCommand::Type::SetGain,
+      .voice = voice,
+      .value = gain,
+  });
+}
+
+void AudioManager::set_pan(VoiceId voice, float pan) {
+  send(AudioCommand{
+      .type = AudioCommand::Type::SetPan,
+      .voice = voice,
+      .value = pan,
+  });
+}
+
+void AudioManager::fade(
+    VoiceId voice,
+    float target_gain,
+    float duration_s,
+    bool stop_when_done) {
+  send(AudioCommand{
+      .type = AudioCommand::Type::Fade,
+      .voice = voice,
+      .value = target_gain,
+      .frame_count = static_cast<size_t>(
+          std::max(0.0f, duration_s) * DEFAULT_AUDIO_SPEC.freq),
+      .stop_when_done = stop_when_done,
+  });
+}
+
+void AudioManager::stop_all_sounds() {
+  // Holding the stream's lock keeps the audio callback from running, so this
+  // thread can stand in as the queue's consumer. Commands already queued are
+  // applied first so that a queued play cannot start after the stop.
+  SDL_LockAudioStream(default_audio_stream_.get());
+  apply_commands();
+  mixer_.stop_all();
+  SDL_UnlockAudioStream(default_audio_stream_.get());
+}
+
+bool AudioManager::send(const AudioCommand& command) {
+  if (!commands_.try_push(command)) {
+    SDL_LogWarn(
+        FORGE_LOG_CATEGORY_AUDIO,
+        "audio command queue is full, dropping command type %d",
+        static_cast<int>(command.type));
     return false;
   }
 
-  // Shove the entire audio buffer into the default audio stream.
-  // TODO: Support playing multiple sounds at once.
-  if (!SDL_PutAudioStreamData(
-          default_audio_stream_.get(), buffer->data, buffer->size_in_bytes)) {
+  return true;
+}
+
+void AudioManager::apply_commands() {
+  AudioCommand command;
+
+  while (commands_.try_pop(command)) {
+    switch (command.type) {
+      case AudioCommand::Type::Play:
+        mixer_.play(
+            command.voice,
+            {command.samples, command.sample_count},
+            command.params);
+        break;
+      case AudioCommand::Type::Stop:
+        mixer_.stop(command.voice);
+        break;
+      case AudioCommand::Type::SetGain:
+        mixer_.set_gain(command.voice, command.value);
+        break;
+      case AudioCommand::Type::SetPan:
+        mixer_.set_pan(command.voice, command.value);
+        break;
+      case AudioCommand::Type::Fade:
+        mixer_.fade(
+            command.voice,
+            command.value,
+            command.frame_count,
+            command.stop_when_done);
+        break;
+    }
+  }
+}
+
+bool AudioManager::play_music(const std::string_view filename, bool loop) {
+  stop_music();
+
+  auto music = MusicStream::open(filename, loop);
+
+  if (music == nullptr) {
+    return false;
+  }
+
+  // Size the decode buffer to hold about a tenth of a second of samples, which
+  // is more than the audio device requests per callback.
+  constexpr int kMusicBlocksPerSecond = 10;
+  const auto& music_spec = music->spec();
+
+  music_samples_.resize(
+      static_cast<size_t>(music_spec.freq / kMusicBlocksPerSecond) *
+      music_spec.channels);
+
+  // Let the audio stream convert from the track's own format to the device's,
+  // and decode more of the track whenever the stream runs low.
+  unique_sdl_audio_stream_ptr stream{
+      SDL_CreateAudioStream(&music_spec, &device_audio_spec_)};
+
+  if (stream == nullptr) {
     SDL_LogError(
         FORGE_LOG_CATEGORY_AUDIO,
-        "AudioManager::playOnce SDL_PutAudioStreamData error: %s",
+        "SDL_CreateAudioStream error for music: %s",
         SDL_GetError());
     return false;
   }
 
+  music_ = std::move(music);
+
+  if (!SDL_SetAudioStreamGetCallback(
+          stream.get(),
+          &AudioManager::music_stream_callback,
+          this) ||
+      !SDL_BindAudioStream(audio_device_id_, stream.get())) {
+    SDL_LogError(
+        FORGE_LOG_CATEGORY_AUDIO,
+        "failed to start music stream: %s",
+        SDL_GetError());
+    music_.reset();
+    return false;
+  }
+
+  music_audio_stream_ = std::move(stream);
   return true;
+}
+
+void AudioManager::stop_music() {
+  // Destroying the stream unbinds it from the device and waits for a running
+  // callback to finish, after which the track can be safely released.
+  music_audio_stream_.reset();
+  music_.reset();
+}
+
+void SDLCALL AudioManager::mix_stream_callback(
+    void* userdata,
+    SDL_AudioStream* stream,
+    int additional_amount,
+    int /*total_amount*/) {
+  auto self = static_cast<AudioManager*>(userdata);
+  SDL_assert(self != nullptr);
+
+  // Pick up any commands sent by the game thread since the last callback.
+  self->apply_commands();
+
+  // Mix in blocks no larger than the preallocated buffer until the request is
+  // satisfied.
+  auto& samples = self->mix_samples_;
+  const auto channels = static_cast<size_t>(DEFAULT_AUDIO_SPEC.channels);
+  const auto bytes_per_frame = static_cast<int>(channels * sizeof(float));
+  const auto max_frames = samples.size() / channels;
+
+  while (additional_amount >= bytes_per_frame) {
+    const auto frames = std::min(
+        max_frames,
+        static_cast<size_t>(additional_amount / bytes_per_frame));
+    const auto block = std::span{samples}.first(frames * channels);
+
+    self->mixer_.mix(block);
+
+    const auto block_bytes = static_cast<int>(block.size_bytes());
+    SDL_PutAudioStreamData(stream, block.data(), block_bytes);
+    additional_amount -= block_bytes;
+  }
+}
+
+void SDLCALL AudioManager::music_stream_callback(
+    void* userdata,
+    SDL_AudioStream* stream,
+    int additional_amount,
+    int /*total_amount*/) {
+  auto self = static_cast<AudioManager*>(userdata);
+  SDL_assert(self != nullptr && self->music_ != nullptr);
+
+  // Decode just enough of the track to satisfy the request, one block at a
+  // time. `additional_amount` is measured in bytes of the track's format.
+  auto& samples = self->music_samples_;
+  const auto channels = static_cast<size_t>(self->music_->spec().channels);
+  const auto bytes_per_frame = static_cast<int>(channels * sizeof(float));
+  const auto max_frames = samples.size() / channels;
+
+  while (additional_amount > 0 && !self->music_->finished()) {
+    const auto frames_wanted = std::min(
+        max_frames,
+        static_cast<size_t>(
+            (additional_amount + bytes_per_frame - 1) / bytes_per_frame));
+    const auto frames_read = self->music_->read(
+        std::span{samples}.first(frames_wanted * channels));
+
+    if (frames_read == 0) {
+      break;
+    }
+
+    const auto bytes_read = static_cast<int>(frames_read) * bytes_per_frame;
+
+    SDL_PutAudioStreamData(stream, samples.data(), bytes_read);
+    additional_amount -= bytes_read;
+  }
 }
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include <forge/audio_mixer.h>
+
+#include "support/simd.h"
+
+#include <algorithm>
+#include <utility>
+
+constexpr size_t kStereoChannels = 2;
+
+/// Number of frames mixed with the same gain while a voice is fading. Short
+/// enough that the steps are not audible.
+constexpr size_t kFadeBlockFrames = 64;
+
+/// Accumulates `frame_count` stereo frames of `input` into `output`, scaling
+/// the left and right channels separately.
+static void mix_stereo_frames(
+    float* output,
+    const float* input,
+    size_t frame_count,
+    float left_gain,
+    float right_gain) {
+  const size_t count = frame_count * kStereoChannels;
+  size_t i = 0;
+
+  // Interleaved stereo alternates left and right samples, so a register of
+  // alternating gains lines up with the samples as long as the register holds
+  // whole frames.
+  if constexpr (kSimdWidth >= kStereoChannels) {
+    float gain_pattern[kSimdWidth];
+
+    for (size_t lane = 0; lane < kSimdWidth; ++lane) {
+      gain_pattern[lane] = lane % kStereoChannels == 0 ? left_gain : right_gain;
+    }
+
+    const auto gains = simd_load(gain_pattern);
+
+    for (; i + kSimdWidth <= count; i += kSimdWidth) {
+      simd_store(
+          output + i,
+          simd_load(output + i) + simd_load(input + i) * gains);
+    }
+  }
+
+  for (; i < count; i += kStereoChannels) {
+    output[i] += input[i] * left_gain;
+    output[i + 1] += input[i + 1] * right_gain;
+  }
+}
+
+/// Clamps every sample to the range [-1, 1].
+static void clamp_samples(float* samples, size_t count) {
+  const auto lower = simd_splat(-1.0f);
+  const auto upper = simd_splat(1.0f);
+  size_t i = 0;
+
+  for (; i + kSimdWidth <= count; i += kSimdWidth) {
+    simd_store(
+        samples + i,
+        simd_min(simd_max(simd_load(samples + i), lower), upper));
+  }
+
+  for (; i < count; ++i) {
+    samples[i] = std::clamp(samples[i], -1.0f, 1.0f);
+  }
+}
+
+VoiceId AudioMixer::play(
+    std::span<const float> samples,
+    const VoiceParams& params) {
+  const auto id = create_voice_id();
+  return play(id, samples, params) ? id : kInvalidVoiceId;
+}
+
+bool AudioMixer::play(
+    VoiceId id,
+    std::span<const float> samples,
+    const VoiceParams& params) {
+  const auto frame_count = samples.size() / kStereoChannels;
+
+  if (frame_count == 0 || id == kInvalidVoiceId) {
+    return false;
+  }
+
+  // Use a free voice, or steal the oldest voice that will end by itself.
+  Voice* voice = nullptr;
+
+  for (auto& candidate : voices_) {
+    if (!candidate.active) {
+      voice = &candidate;
+      break;
+    }
+
+    if (!candidate.loop &&
+        (voice == nullptr || candidate.start_order < voice->start_order)) {
+      voice = &candidate;
+    }
+  }
+
+  if (voice == nullptr) {
+    return false;
+  }
+
+  *voice = Voice{
+      .id = id,
+      .samples = samples.data(),
+      .frame_count = frame_count,
+      .gain = params.gain,
+      .pan = params.pan,
+      .loop = params.loop,
+      .active = true,
+      .start_order = next_start_order_++,
+  };
+
+  update_channel_gains(*voice);
+  return true;
+}
+
+VoiceId AudioMixer::create_voice_id() {
+  // Skip the invalid id when the counter wraps around.
+  auto id = next_voice_id_.fetch_add(1, std::memory_order_relaxed);
+
+  if (id == kInvalidVoiceId) {
+    id = next_voice_id_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  return id;
+}
+
+void AudioMixer::stop(VoiceId id) {
+  if (auto voice = find(id); voice != nullptr) {
+    voice->active = false;
+  }
+}
+
+void AudioMixer::stop_all() {
+  for (auto& voice : voices_) {
+    voice.active = false;
+  }
+}
+
+void AudioMixer::set_gain(VoiceId id, float gain) {
+  if (auto voice = find(id); voice != nullptr) {
+    voice->gain = gain;
+    voice->fade_frames_left = 0;
+    update_channel_gains(*voice);
+  }
+}
+
+void AudioMixer::set_pan(VoiceId id, float pan) {
+  if (auto voice = find(id); voice != nullptr) {
+    voice->pan = pan;
+    update_channel_gains(*voice);
+  }
+}
+
+void AudioMixer::fade(
+    VoiceId id,
+    float target_gain,
+    size_t frame_count,
+    bool stop_when_done) {
+  auto voice = find(id);
+
+  if (voice == nullptr) {
+    return;
+  }
+
+  // Fading over zero frames jumps straight to the target.
+  frame_count = std::max<size_t>(frame_count, 1);
+
+  voice->fade_step =
+      (target_gain - voice->gain) / static_cast<float>(frame_count);
+  voice->fade_target = target_gain;
+  voice->fade_frames_left = frame_count;
+  voice->stop_after_fade = stop_when_done;
+}
+
+bool AudioMixer::is_playing(VoiceId id) const {
+  return find(id) != nullptr;
+}
+
+size_t AudioMixer::active_voice_count() const {
+  return std::ranges::count_if(voices_, &Voice::active);
+}
+
+void AudioMixer::mix(std::span<float> output) {
+  std::ranges::fill(output, 0.0f);
+
+  for (auto& voice : voices_) {
+    if (!voice.active) {
+      continue;
+    }
+
+    if (voice.fade_frames_left == 0) {
+      mix_voice(voice, output);
+      continue;
+    }
+
+    // Mix fading voices in short blocks, stepping the gain between blocks.
+    auto remaining = output;
+
+    while (!remaining.empty() && voice.active && voice.fade_frames_left > 0) {
+      const auto frames = std::min(
+          {remaining.size() / kStereoChannels,
+           voice.fade_frames_left,
+           kFadeBlockFrames});
+
+      mix_voice(voice, remaining.first(frames * kStereoChannels));
+      remaining = remaining.subspan(frames * kStereoChannels);
+
+      voice.fade_frames_left -= frames;
+      voice.gain += voice.fade_step * static_cast<float>(frames);
+
+      if (voice.fade_frames_left == 0) {
+        voice.gain = voice.fade_target;
+      }
+
+      update_channel_gains(voice);
+
+      if (voice.fade_frames_left == 0 && voice.stop_after_fade) {
+        voice.active = false;
+      }
+    }
+
+    if (voice.active && !remaining.empty()) {
+      mix_voice(voice, remaining);
+    }
+  }
+
+  clamp_samples(output.data(), output.size());
+}
+
+void AudioMixer::mix_voice(Voice& voice, std::span<float> output) {
+  const auto output_frames = output.size() / kStereoChannels;
+
+  // Add the voice's sound to the output, wrapping around to the start as many
+  // times as needed when the voice loops.
+  size_t frames_mixed = 0;
+
+  while (frames_mixed < output_frames) {
+    const auto frames = std::min(
+        output_frames - frames_mixed,
+        voice.frame_count - voice.position);
+
+    mix_stereo_frames(
+        output.data() + frames_mixed * kStereoChannels,
+        voice.samples + voice.position * kStereoChannels,
+        frames,
+        voice.left_gain,
+        voice.right_gain);
+
+    frames_mixed += frames;
+    voice.position += frames;
+
+    if (voice.position == voice.frame_count) {
+      if (!voice.loop) {
+        voice.active = false;
+        break;
+      }
+
+      voice.position = 0;
+    }
+  }
+}
+
+AudioMixer::Voice* AudioMixer::find(VoiceId id) {
+  return const_cast<Voice*>(std::as_const(*this).find(id));
+}
+
+const AudioMixer::Voice* AudioMixer::find(VoiceId id) const {
+  if (id == kInvalidVoiceId) {
+    return nullptr;
+  }
+
+  for (const auto& voice : voices_) {
+    if (voice.active && voice.id == id) {
+      return &voice;
+    }
+  }
+
+  return nullptr;
+}
+
+void AudioMixer::update_channel_gains(Voice& voice) {
+  // Balance panning: the far channel fades out while the near channel stays at
+  // full volume.
+  const auto pan = std::clamp(voice.pan, -1.0f, 1.0f);
+
+  voice.left_gain = voice.gain * std::min(1.0f, 1.0f - pan);
+  voice.right_gain = voice.gain * std::min(1.0f, 1.0f + pan);
+}
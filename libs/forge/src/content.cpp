@@ -2,6 +2,10 @@
 
 #include <forge/content.h>
 
+#include <forge/content_archive.h>
+#include <forge/decode_cache.h>
+#include <forge/pixel_format.h>
+
 #include <forge/support/sdl_support.h>
 #include <forge/support/stb_support.h>
 
@@ -9,71 +13,200 @@
 #include <stb/stb_image.h>
 #include <stb/stb_vorbis.h>
 
+#include <filesystem>
 #include <format>
+#include <limits>
+#include <optional>
+
+/// The content archive mounted by `mount_content_archive`, or null.
+static std::unique_ptr<ContentArchive> GContentArchive;
+
+/// The decode cache enabled by `enable_decode_cache`, or null.
+static std::unique_ptr<DecodeCache> GDecodeCache;
+
+/// Get the bytes of a file in the mounted content archive.
+static std::optional<std::span<const unsigned char>>
+    find_archived_content(const std::string_view filename) {
+  if (GContentArchive == nullptr) {
+    return std::nullopt;
+  }
+
+  return GContentArchive->find(filename);
+}
 
 std::unique_ptr<SDL_Texture, SdlTextureCloser>
     load_texture(SDL_Renderer* renderer, const std::string_view filename) {
   SDL_assert(renderer != nullptr);
 
-  // Create the final file path relative to the game's resource directory.
-  const auto full_path = std::format("{}{}", SDL_GetBasePath(), filename);
+  auto image = decode_image(filename);
+
+  if (image.pixels == nullptr) {
+    return nullptr;
+  }
+
+  return create_texture(renderer, std::move(image), filename);
+}
+
+/// Decodes an image through the decode cache. The whole file is read up front
+/// since it must be hashed before the cache can be checked, and a miss decodes
+/// those bytes from memory. That is already a single large read, so unlike the
+/// uncached path in `decode_image` there is nothing for a `BufferedSdlReader`
+/// to batch.
+static DecodedImage decode_cached_image(
+    const DecodeCache& cache,
+    const std::string_view filename) {
+  const auto source = read_content(filename);
+
+  if (source.empty()) {
+    return {};
+  }
+
+  if (auto cached = cache.find_image(source.bytes()); cached.has_value()) {
+    SDL_LogMessage(
+        SDL_LOG_CATEGORY_APPLICATION,
+        SDL_LOG_PRIORITY_INFO,
+        "loading texture %.*s from decode cache",
+        static_cast<int>(filename.length()),
+        filename.data());
+
+    return std::move(*cached);
+  }
 
   SDL_LogMessage(
       SDL_LOG_CATEGORY_APPLICATION,
       SDL_LOG_PRIORITY_INFO,
-      "loading texture %.*s from path %s",
+      "decoding texture %.*s into decode cache",
       static_cast<int>(filename.length()),
-      filename.data(),
-      full_path.c_str());
+      filename.data());
 
-  // Read the requested file by wrapping stb_image's io callbacks with SDL's
-  // IO streams API.
-  std::unique_ptr<SDL_IOStream, SdlIoCloser> file_io_stream{
-      SDL_IOFromFile(full_path.c_str(), "rb")};
+  SDL_assert(source.bytes().size() <= std::numeric_limits<int>::max());
 
-  if (file_io_stream == nullptr) {
+  DecodedImage image;
+  image.pixels.reset(stbi_load_from_memory(
+      source.bytes().data(),
+      static_cast<int>(source.bytes().size()),
+      &image.width,
+      &image.height,
+      nullptr,
+      STBI_rgb_alpha));
+
+  if (image.pixels == nullptr) {
     SDL_LogError(
         SDL_LOG_CATEGORY_APPLICATION,
-        "failed to open file io stream: %s",
-        SDL_GetError());
+        "failed to load texture: %s",
+        stbi_failure_reason());
+    return {};
+  }
 
-    return nullptr;
+  cache.store_image(source.bytes(), image);
+  return image;
+}
+
+DecodedImage decode_image(const std::string_view filename) {
+  if (GDecodeCache != nullptr) {
+    return decode_cached_image(*GDecodeCache, filename);
   }
 
-  // Load image from disk into raw RGBA bytes using stb_image.
-  const auto stbio = create_stbi_sdl2_io_callbacks();
-  int width = 0, height = 0;
+  DecodedImage image;
 
-  std::unique_ptr<unsigned char, StbImageBytesDeleter> image_bytes{
-      stbi_load_from_callbacks(
-          &stbio,
-          file_io_stream.get(),
-          &width,
-          &height,
-          nullptr,
-          STBI_rgb_alpha)};
+  if (auto archived_bytes = find_archived_content(filename);
+      archived_bytes.has_value()) {
+    // Decode the image directly from the mounted archive.
+    SDL_LogMessage(
+        SDL_LOG_CATEGORY_APPLICATION,
+        SDL_LOG_PRIORITY_INFO,
+        "loading texture %.*s from content archive",
+        static_cast<int>(filename.length()),
+        filename.data());
 
-  if (image_bytes == nullptr) {
+    SDL_assert(archived_bytes->size() <= std::numeric_limits<int>::max());
+
+    image.pixels.reset(stbi_load_from_memory(
+        archived_bytes->data(),
+        static_cast<int>(archived_bytes->size()),
+        &image.width,
+        &image.height,
+        nullptr,
+        STBI_rgb_alpha));
+  } else {
+    // Create the final file path relative to the game's resource directory.
+    const auto full_path = std::format("{}{}", SDL_GetBasePath(), filename);
+
+    SDL_LogMessage(
+        SDL_LOG_CATEGORY_APPLICATION,
+        SDL_LOG_PRIORITY_INFO,
+        "loading texture %.*s from path %s",
+        static_cast<int>(filename.length()),
+        filename.data(),
+        full_path.c_str());
+
+    // Read the requested file by wrapping stb_image's io callbacks with SDL's
+    // IO streams API, buffered so that stb_image's many small reads become a
+    // few large reads from the file.
+    std::unique_ptr<SDL_IOStream, SdlIoCloser> file_io_stream{
+        SDL_IOFromFile(full_path.c_str(), "rb")};
+
+    if (file_io_stream == nullptr) {
+      SDL_LogError(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "failed to open file io stream: %s",
+          SDL_GetError());
+
+      return {};
+    }
+
+    // Load image from disk into raw RGBA bytes using stb_image.
+    BufferedSdlReader reader{file_io_stream.get()};
+    const auto stbio = create_stbi_buffered_io_callbacks();
+
+    image.pixels.reset(stbi_load_from_callbacks(
+        &stbio,
+        &reader,
+        &image.width,
+        &image.height,
+        nullptr,
+        STBI_rgb_alpha));
+  }
+
+  if (image.pixels == nullptr) {
     SDL_LogError(
         SDL_LOG_CATEGORY_APPLICATION,
         "failed to load texture: %s",
         stbi_failure_reason());
-    return nullptr;
+    return {};
   }
 
-  // Create a new SDL texture with the same size as the loaded image, and then
-  // blit the pixel bytes into the newly created texture.
-  constexpr int RGBA_BYTES_PER_PIXEL = 4; // RGBA
+  return image;
+}
 
-  std::unique_ptr<SDL_Surface, SdlSurfaceCloser> surface{SDL_CreateSurfaceFrom(
-      width,
-      height,
-      SDL_PIXELFORMAT_ARGB8888,
-      image_bytes.get(),
-      width * RGBA_BYTES_PER_PIXEL)};
+unique_sdl_texture_ptr create_texture(
+    SDL_Renderer* renderer,
+    DecodedImage image,
+    const std::string_view filename) {
+  SDL_assert(renderer != nullptr);
+  SDL_assert(image.pixels != nullptr);
+
+  constexpr int RGBA_BYTES_PER_PIXEL = 4; // RGBA
+  const auto pitch = image.width * RGBA_BYTES_PER_PIXEL;
+
+  // Create the texture in a layout the renderer supports so that updating it
+  // is a single copy. Decoded images are RGBA, and only need their red and
+  // blue channels swapped for renderers that want BGRA.
+  const auto format = native_rgba_format(renderer);
+
+  if (format == SDL_PIXELFORMAT_BGRA32) {
+    swap_red_blue({
+        image.pixels.get(),
+        static_cast<size_t>(pitch) * static_cast<size_t>(image.height),
+    });
+  }
 
-  std::unique_ptr<SDL_Texture, SdlTextureCloser> texture{
-      SDL_CreateTextureFromSurface(renderer, surface.get())};
+  std::unique_ptr<SDL_Texture, SdlTextureCloser> texture{SDL_CreateTexture(
+      renderer,
+      format,
+      SDL_TEXTUREACCESS_STATIC,
+      image.width,
+      image.height)};
 
   if (texture == nullptr) {
     SDL_LogError(
@@ -84,12 +217,24 @@ std::unique_ptr<SDL_Texture, SdlTextureCloser>
     return nullptr;
   }
 
+  if (!SDL_UpdateTexture(texture.get(), nullptr, image.pixels.get(), pitch)) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "failed to copy pixels when loading texture: %s",
+        SDL_GetError());
+
+    return nullptr;
+  }
+
+  SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+
   SDL_LogMessage(
       SDL_LOG_CATEGORY_APPLICATION,
       SDL_LOG_PRIORITY_DEBUG,
-      "loaded texture width = %d, height = %d, file = %.*s",
-      width,
-      height,
+      "loaded texture width = %d, height = %d, format = %s, file = %.*s",
+      image.width,
+      image.height,
+      SDL_GetPixelFormatName(format),
       static_cast<int>(filename.length()),
       filename.data());
 
@@ -97,6 +242,13 @@ std::unique_ptr<SDL_Texture, SdlTextureCloser>
 }
 
 std::vector<unsigned char> load_binary(const std::string_view filename) {
+  // Copy the file out of the mounted archive when possible. Prefer
+  // `read_content` to avoid the copy.
+  if (auto archived_bytes = find_archived_content(filename);
+      archived_bytes.has_value()) {
+    return {archived_bytes->begin(), archived_bytes->end()};
+  }
+
   const auto full_path = std::format("{}{}", SDL_GetBasePath(), filename);
 
   // Open file stream to the binary file.
@@ -149,23 +301,43 @@ std::vector<unsigned char> load_binary(const std::string_view filename) {
 }
 
 std::unique_ptr<SdlAudioBuffer> load_ogg(const std::string_view filename) {
-  // Fully load the file as a binary blob.
+  // Fully load the file as a binary blob, which is a view into the mounted
+  // content archive when the archive contains the file.
   //
-  // This can be optimized later to read only chunks of the file, decode, and
-  // pushed into an SDL audio buffer as an optimization task.
-  std::vector<unsigned char> ogg_bytes = load_binary(filename);
+  // The whole file is decoded up front, which suits short sound effects. Long
+  // tracks should be streamed with `MusicStream` instead.
+  const auto ogg_file = read_content(filename);
+  const auto ogg_bytes = ogg_file.bytes();
 
   if (ogg_bytes.empty()) {
     return nullptr;
   }
 
+  // Skip decoding and resampling entirely when the cache already holds the
+  // converted samples.
+  if (GDecodeCache != nullptr) {
+    if (auto cached = GDecodeCache->find_audio(ogg_bytes, DEFAULT_AUDIO_SPEC);
+        cached != nullptr) {
+      SDL_LogMessage(
+          SDL_LOG_CATEGORY_APPLICATION,
+          SDL_LOG_PRIORITY_DEBUG,
+          "loaded ogg audio file %.*s from decode cache",
+          static_cast<int>(filename.length()),
+          filename.data());
+
+      return cached;
+    }
+  }
+
+  SDL_assert(ogg_bytes.size() <= std::numeric_limits<int>::max());
+
   // Decode the ogg file into an array of S16 samples.
   auto audio_buffer = std::make_unique<SdlAudioBuffer>();
   audio_buffer->spec.format = SDL_AUDIO_S16;
 
   const auto samples_read = stb_vorbis_decode_memory(
       ogg_bytes.data(),
-      ogg_bytes.size(),
+      static_cast<int>(ogg_bytes.size()),
       &(audio_buffer->spec.channels),
       &(audio_buffer->spec.freq),
       reinterpret_cast<short**>(&(audio_buffer->data)));
@@ -205,18 +377,45 @@ std::unique_ptr<SdlAudioBuffer> load_ogg(const std::string_view filename) {
       static_cast<int>(filename.length()),
       filename.data());
 
-  return resample_if_needed(std::move(audio_buffer), DEFAULT_AUDIO_SPEC);
+  auto resampled =
+      resample_if_needed(std::move(audio_buffer), DEFAULT_AUDIO_SPEC);
+
+  if (GDecodeCache != nullptr && resampled != nullptr) {
+    GDecodeCache->store_audio(ogg_bytes, *resampled);
+  }
+
+  return resampled;
 }
 
 std::unique_ptr<SdlAudioBuffer> load_wav(const std::string_view filename) {
-  // Create the final file path relative to the game's resource directory.
-  const auto full_path = std::format("{}{}", SDL_GetBasePath(), filename);
+  // Read the wav file from the mounted archive if it is there, otherwise from
+  // the game's resource directory.
+  SDL_IOStream* wav_io_stream = nullptr;
+
+  if (auto archived_bytes = find_archived_content(filename);
+      archived_bytes.has_value()) {
+    wav_io_stream =
+        SDL_IOFromConstMem(archived_bytes->data(), archived_bytes->size());
+  } else {
+    const auto full_path = std::format("{}{}", SDL_GetBasePath(), filename);
+    wav_io_stream = SDL_IOFromFile(full_path.c_str(), "rb");
+  }
 
-  // Load the wav file using SDL3.
+  if (wav_io_stream == nullptr) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "failed to open file io stream: %s",
+        SDL_GetError());
+
+    return nullptr;
+  }
+
+  // Load the wav file using SDL3, which also closes the stream.
   auto audio_buffer = std::make_unique<SdlAudioBuffer>();
 
-  if (!SDL_LoadWAV(
-          full_path.c_str(),
+  if (!SDL_LoadWAV_IO(
+          wav_io_stream,
+          true,
           &audio_buffer->spec,
           &audio_buffer->data,
           &audio_buffer->size_in_bytes)) {
@@ -238,4 +437,61 @@ std::unique_ptr<SdlAudioBuffer> load_wav(const std::string_view filename) {
       filename.data());
 
   return resample_if_needed(std::move(audio_buffer), DEFAULT_AUDIO_SPEC);
+}
+
+bool mount_content_archive(const std::string_view filename) {
+  const auto full_path = std::format("{}{}", SDL_GetBasePath(), filename);
+  auto archive = ContentArchive::open(full_path);
+
+  if (archive == nullptr) {
+    return false;
+  }
+
+  GContentArchive = std::move(archive);
+  return true;
+}
+
+void unmount_content_archive() {
+  GContentArchive.reset();
+}
+
+bool enable_decode_cache(const std::string_view directory) {
+  const std::string directory_path{directory};
+
+  if (!SDL_GetPathInfo(directory_path.c_str(), nullptr) &&
+      !SDL_CreateDirectory(directory_path.c_str())) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "failed to create decode cache directory %s: %s",
+        directory_path.c_str(),
+        SDL_GetError());
+
+    return false;
+  }
+
+  SDL_LogMessage(
+      SDL_LOG_CATEGORY_APPLICATION,
+      SDL_LOG_PRIORITY_INFO,
+      "decode cache directory is %s",
+      directory_path.c_str());
+
+  GDecodeCache = std::make_unique<DecodeCache>(directory_path);
+  return true;
+}
+
+void disable_decode_cache() {
+  GDecodeCache.reset();
+}
+
+ContentBytes read_content(const std::string_view filename) {
+  if (auto archived_bytes = find_archived_content(filename);
+      archived_bytes.has_value()) {
+    return ContentBytes{*archived_bytes};
+  }
+
+  return ContentBytes{load_binary(filename)};
+}
+
+std::string normalize_content_path(const std::string_view filename) {
+  return std::filesystem::path{filename}.lexically_normal().generic_string();
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <forge/content_archive.h>
+
+#include <forge/content.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstring>
+
+std::unique_ptr<ContentArchive> ContentArchive::open(const std::string& path) {
+  auto file = MappedFile::open(path);
+
+  if (file == nullptr) {
+    return nullptr;
+  }
+
+  std::unique_ptr<ContentArchive> archive{new ContentArchive(std::move(file))};
+
+  if (!archive->validate(path)) {
+    return nullptr;
+  }
+
+  SDL_LogMessage(
+      SDL_LOG_CATEGORY_APPLICATION,
+      SDL_LOG_PRIORITY_INFO,
+      "opened content archive %s with %d files%s",
+      path.c_str(),
+      static_cast<int>(archive->size()),
+      archive->file_->is_mapped() ? "" : " (not memory mapped)");
+
+  return archive;
+}
+
+ContentArchive::ContentArchive(std::unique_ptr<MappedFile> file)
+    : file_(std::move(file)) {}
+
+bool ContentArchive::validate(const std::string& path) {
+  const auto bytes = file_->bytes();
+
+  // Check the header before trusting any of the sizes in it.
+  ContentArchiveHeader header;
+
+  if (bytes.size() < sizeof(header)) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "content archive %s is too small to be an archive",
+        path.c_str());
+    return false;
+  }
+
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  if (std::memcmp(
+          header.magic,
+          kContentArchiveMagic,
+          sizeof(kContentArchiveMagic)) != 0) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "file %s is not a content archive",
+        path.c_str());
+    return false;
+  }
+
+  if (header.version != kContentArchiveVersion) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "content archive %s has version %u but expected version %u",
+        path.c_str(),
+        header.version,
+        kContentArchiveVersion);
+    return false;
+  }
+
+  // Copy the entry table out of the archive, since the mapping gives no
+  // alignment guarantees for reading the entries in place.
+  const uint64_t entries_size =
+      uint64_t{header.entry_count} * sizeof(ContentArchiveEntry);
+  const uint64_t path_table_offset = sizeof(header) + entries_size;
+
+  if (path_table_offset + header.path_table_size > bytes.size()) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "content archive %s is truncated",
+        path.c_str());
+    return false;
+  }
+
+  entries_.resize(header.entry_count);
+  std::memcpy(entries_.data(), bytes.data() + sizeof(header), entries_size);
+
+  path_table_ = std::string_view{
+      reinterpret_cast<const char*>(bytes.data() + path_table_offset),
+      header.path_table_size};
+
+  // Make sure every entry points inside the archive, and that the entries are
+  // sorted so that `find` can binary search them.
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const auto& entry = entries_[i];
+
+    if (entry.offset > bytes.size() ||
+        entry.size > bytes.size() - entry.offset ||
+        uint64_t{entry.path_offset} + entry.path_length > path_table_.size()) {
+      SDL_LogError(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "content archive %s has an invalid entry at index %d",
+          path.c_str(),
+          static_cast<int>(i));
+      return false;
+    }
+
+    if (i > 0 && entry_path(entries_[i - 1]) >= entry_path(entry)) {
+      SDL_LogError(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "content archive %s entries are not sorted by path",
+          path.c_str());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::optional<std::span<const unsigned char>>
+    ContentArchive::find(const std::string_view filename) const {
+  const auto path = normalize_content_path(filename);
+
+  auto itr = std::ranges::lower_bound(
+      entries_,
+      std::string_view{path},
+      {},
+      [this](const ContentArchiveEntry& entry) { return entry_path(entry); });
+
+  if (itr == entries_.end() || entry_path(*itr) != path) {
+    return std::nullopt;
+  }
+
+  return file_->bytes().subspan(itr->offset, itr->size);
+}
+
+std::string_view
+    ContentArchive::entry_path(const ContentArchiveEntry& entry) const {
+  return path_table_.substr(entry.path_offset, entry.path_length);
+}
@@ -0,0 +1,235 @@
+#include <forge/content_cache.h>
+
+#include <forge/content.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <vector>
+
+ContentCache::ContentCache(SDL_Renderer* renderer, size_t memory_budget)
+    : renderer_(renderer),
+      memory_budget_(memory_budget) {}
+
+std::shared_ptr<SDL_Texture>
+    ContentCache::texture(const std::string_view filename) {
+  auto key = normalize_path(filename);
+
+  if (auto entry = find(key); entry != nullptr) {
+    return entry->texture;
+  }
+
+  if (renderer_ == nullptr) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "cannot load texture %s without a renderer",
+        key.c_str());
+    return nullptr;
+  }
+
+  std::shared_ptr<SDL_Texture> texture{load_texture(renderer_, key)};
+
+  if (texture == nullptr) {
+    return nullptr;
+  }
+
+  return insert_texture(std::move(key), std::move(texture));
+}
+
+std::shared_ptr<const SdlAudioBuffer>
+    ContentCache::ogg(const std::string_view filename) {
+  return cached_audio(filename, [](const std::string& key) {
+    return load_ogg(key);
+  });
+}
+
+std::shared_ptr<const SdlAudioBuffer>
+    ContentCache::wav(const std::string_view filename) {
+  return cached_audio(filename, [](const std::string& key) {
+    return load_wav(key);
+  });
+}
+
+template<typename LoadFunc>
+std::shared_ptr<const SdlAudioBuffer> ContentCache::cached_audio(
+    const std::string_view filename,
+    LoadFunc&& load) {
+  auto key = normalize_path(filename);
+
+  if (auto entry = find(key); entry != nullptr) {
+    return entry->audio;
+  }
+
+  std::shared_ptr<const SdlAudioBuffer> audio{load(key)};
+
+  if (audio == nullptr) {
+    return nullptr;
+  }
+
+  return insert_audio(std::move(key), std::move(audio));
+}
+
+std::shared_ptr<SDL_Texture>
+    ContentCache::find_texture(const std::string_view filename) {
+  const auto entry = find(normalize_path(filename));
+  return entry != nullptr ? entry->texture : nullptr;
+}
+
+std::shared_ptr<const SdlAudioBuffer>
+    ContentCache::find_audio(const std::string_view filename) {
+  const auto entry = find(normalize_path(filename));
+  return entry != nullptr ? entry->audio : nullptr;
+}
+
+std::shared_ptr<SDL_Texture> ContentCache::add_texture(
+    const std::string_view filename,
+    unique_sdl_texture_ptr texture) {
+  SDL_assert(texture != nullptr);
+
+  auto key = normalize_path(filename);
+
+  if (auto entry = find(key); entry != nullptr) {
+    return entry->texture;
+  }
+
+  return insert_texture(
+      std::move(key),
+      std::shared_ptr<SDL_Texture>{std::move(texture)});
+}
+
+std::shared_ptr<const SdlAudioBuffer> ContentCache::add_audio(
+    const std::string_view filename,
+    std::unique_ptr<SdlAudioBuffer> audio) {
+  SDL_assert(audio != nullptr);
+
+  auto key = normalize_path(filename);
+
+  if (auto entry = find(key); entry != nullptr) {
+    return entry->audio;
+  }
+
+  return insert_audio(
+      std::move(key),
+      std::shared_ptr<const SdlAudioBuffer>{std::move(audio)});
+}
+
+void ContentCache::set_memory_budget(size_t memory_budget) {
+  memory_budget_ = memory_budget;
+  trim();
+}
+
+size_t ContentCache::trim() {
+  if (memory_used_ <= memory_budget_) {
+    return 0;
+  }
+
+  // Gather unreferenced entries from least to most recently used.
+  std::vector<decltype(entries_)::iterator> candidates;
+
+  for (auto itr = entries_.begin(); itr != entries_.end(); ++itr) {
+    if (!itr->second.is_referenced()) {
+      candidates.push_back(itr);
+    }
+  }
+
+  std::ranges::sort(candidates, [](const auto& a, const auto& b) {
+    return a->second.last_used < b->second.last_used;
+  });
+
+  // Evict until the cache fits in the budget or there is nothing left that
+  // can be evicted.
+  size_t evicted_count = 0;
+
+  for (const auto& itr : candidates) {
+    if (memory_used_ <= memory_budget_) {
+      break;
+    }
+
+    SDL_LogMessage(
+        SDL_LOG_CATEGORY_APPLICATION,
+        SDL_LOG_PRIORITY_DEBUG,
+        "evicting %s from content cache",
+        itr->first.c_str());
+
+    memory_used_ -= itr->second.size_in_bytes;
+    entries_.erase(itr);
+    evicted_count++;
+  }
+
+  if (memory_used_ > memory_budget_) {
+    SDL_LogWarn(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "content cache is over budget with referenced content, used = %zu, "
+        "budget = %zu",
+        memory_used_,
+        memory_budget_);
+  }
+
+  return evicted_count;
+}
+
+size_t ContentCache::evict_unreferenced() {
+  return std::erase_if(entries_, [this](const auto& key_and_entry) {
+    if (key_and_entry.second.is_referenced()) {
+      return false;
+    }
+
+    memory_used_ -= key_and_entry.second.size_in_bytes;
+    return true;
+  });
+}
+
+std::string ContentCache::normalize_path(const std::string_view filename) {
+  return normalize_content_path(filename);
+}
+
+ContentCache::Entry* ContentCache::find(const std::string& key) {
+  auto itr = entries_.find(key);
+
+  if (itr == entries_.end()) {
+    return nullptr;
+  }
+
+  itr->second.last_used = ++use_counter_;
+  return &itr->second;
+}
+
+std::shared_ptr<SDL_Texture> ContentCache::insert_texture(
+    std::string key,
+    std::shared_ptr<SDL_Texture> texture) {
+  // Estimate the texture's memory use from its size, assuming four bytes per
+  // pixel.
+  float width = 0.0f, height = 0.0f;
+  SDL_GetTextureSize(texture.get(), &width, &height);
+
+  Entry entry;
+  entry.texture = texture;
+  entry.size_in_bytes = static_cast<size_t>(width * height) * 4;
+  insert(std::move(key), std::move(entry));
+
+  return texture;
+}
+
+std::shared_ptr<const SdlAudioBuffer> ContentCache::insert_audio(
+    std::string key,
+    std::shared_ptr<const SdlAudioBuffer> audio) {
+  Entry entry;
+  entry.audio = audio;
+  entry.size_in_bytes = audio->size_in_bytes;
+  insert(std::move(key), std::move(entry));
+
+  return audio;
+}
+
+void ContentCache::insert(std::string key, Entry entry) {
+  entry.last_used = ++use_counter_;
+  memory_used_ += entry.size_in_bytes;
+  entries_.emplace(std::move(key), std::move(entry));
+
+  trim();
+}
+
+bool ContentCache::Entry::is_referenced() const {
+  // The cache holds one reference itself, so any other owner keeps the entry.
+  return texture.use_count() > 1 || audio.use_count() > 1;
+}
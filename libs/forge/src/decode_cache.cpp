@@ -0,0 +1,465 @@
+#include <forge/decode_cache.h>
+
+#include <forge/support/mapped_file.h>
+#include <forge/support/sdl_support.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+constexpr uint64_t kBytesPerPixel = 4; // RGBA
+
+namespace {
+  uint64_t read_u64(const unsigned char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+
+  uint32_t read_u32(const unsigned char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+
+  uint64_t accumulate(uint64_t accumulator, uint64_t input) {
+    accumulator += input * kPrime2;
+    accumulator = std::rotl(accumulator, 31);
+    return accumulator * kPrime1;
+  }
+
+  uint64_t merge_round(uint64_t hash, uint64_t accumulator) {
+    hash ^= accumulate(0, accumulator);
+    return hash * kPrime1 + kPrime4;
+  }
+
+  /// Target format that a cache entry was decoded into, which is hashed into
+  /// the entry's key along with the source bytes.
+  struct EntryTarget {
+    uint32_t kind = 0;
+    uint32_t format = 0;
+    int32_t channels = 0;
+    int32_t freq = 0;
+  };
+
+  uint64_t entry_key(
+      std::span<const unsigned char> source,
+      const EntryTarget& target) {
+    const auto seed = hash_bytes(
+        {reinterpret_cast<const unsigned char*>(&target), sizeof(target)});
+
+    return hash_bytes(source, seed);
+  }
+
+  /// Marks a cache file as just used by setting its modification time, which
+  /// `DecodeCache::trim` deletes files in order of. SDL has no way to set file
+  /// times.
+  void touch_entry(const std::string& path) {
+    std::error_code error;
+    std::filesystem::last_write_time(
+        path,
+        std::filesystem::file_time_type::clock::now(),
+        error);
+  }
+
+  /// Maps the cache file for `key` and checks that it holds a payload of the
+  /// expected kind and format decoded from `source`.
+  ///
+  /// @returns The mapped file, or null if there is no valid entry.
+  std::unique_ptr<MappedFile> open_entry(
+      const std::string& path,
+      uint64_t key,
+      std::span<const unsigned char> source,
+      const EntryTarget& target,
+      DecodeCacheHeader& header) {
+    // Check that the file exists first, since a miss is expected and should
+    // not be logged as an error by `MappedFile`.
+    if (!SDL_GetPathInfo(path.c_str(), nullptr)) {
+      return nullptr;
+    }
+
+    auto file = MappedFile::open(path);
+
+    if (file == nullptr) {
+      return nullptr;
+    }
+
+    const auto bytes = file->bytes();
+
+    if (bytes.size() < sizeof(header)) {
+      SDL_LogWarn(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "ignoring truncated decode cache file %s",
+          path.c_str());
+      return nullptr;
+    }
+
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    // A different version is expected after upgrading the game, so only a
+    // corrupt entry is worth a warning.
+    if (std::memcmp(
+            header.magic,
+            kDecodeCacheMagic,
+            sizeof(kDecodeCacheMagic)) != 0 ||
+        header.version != kDecodeCacheVersion) {
+      return nullptr;
+    }
+
+    if (header.key != key || header.source_size != source.size() ||
+        header.kind != target.kind || header.format != target.format ||
+        header.payload_size != bytes.size() - sizeof(header)) {
+      SDL_LogWarn(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "ignoring mismatched decode cache file %s",
+          path.c_str());
+      return nullptr;
+    }
+
+    touch_entry(path);
+    return file;
+  }
+} // namespace
+
+uint64_t hash_bytes(std::span<const unsigned char> bytes, uint64_t seed) {
+  const auto* p = bytes.data();
+  const auto* const end = p + bytes.size();
+  uint64_t hash;
+
+  if (bytes.size() >= 32) {
+    // Hash 32 byte stripes with four independent accumulators, which keeps
+    // several multiplies in flight at once.
+    uint64_t v1 = seed + kPrime1 + kPrime2;
+    uint64_t v2 = seed + kPrime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - kPrime1;
+
+    for (; end - p >= 32; p += 32) {
+      v1 = accumulate(v1, read_u64(p));
+      v2 = accumulate(v2, read_u64(p + 8));
+      v3 = accumulate(v3, read_u64(p + 16));
+      v4 = accumulate(v4, read_u64(p + 24));
+    }
+
+    hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) +
+           std::rotl(v4, 18);
+    hash = merge_round(hash, v1);
+    hash = merge_round(hash, v2);
+    hash = merge_round(hash, v3);
+    hash = merge_round(hash, v4);
+  } else {
+    hash = seed + kPrime5;
+  }
+
+  hash += bytes.size();
+
+  // Mix in the bytes left over from the stripes.
+  for (; end - p >= 8; p += 8) {
+    hash ^= accumulate(0, read_u64(p));
+    hash = std::rotl(hash, 27) * kPrime1 + kPrime4;
+  }
+
+  if (end - p >= 4) {
+    hash ^= read_u32(p) * kPrime1;
+    hash = std::rotl(hash, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+
+  for (; p < end; ++p) {
+    hash ^= *p * kPrime5;
+    hash = std::rotl(hash, 11) * kPrime1;
+  }
+
+  // Avalanche so every input bit affects every output bit.
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+
+  return hash;
+}
+
+DecodeCache::DecodeCache(std::string directory, uint64_t size_limit)
+    : directory_(std::move(directory)), size_limit_(size_limit) {
+  trim();
+}
+
+std::optional<DecodedImage>
+    DecodeCache::find_image(std::span<const unsigned char> source) const {
+  const EntryTarget target{
+      .kind = static_cast<uint32_t>(DecodeCacheKind::Image),
+      .format = SDL_PIXELFORMAT_RGBA32,
+  };
+
+  const auto key = entry_key(source, target);
+  const auto path = entry_path(key);
+  DecodeCacheHeader header;
+  const auto file = open_entry(path, key, source, target, header);
+
+  if (file == nullptr) {
+    return std::nullopt;
+  }
+
+  if (header.width_or_channels <= 0 || header.height_or_freq <= 0 ||
+      header.payload_size != kBytesPerPixel * header.width_or_channels *
+                                 header.height_or_freq) {
+    SDL_LogWarn(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "ignoring decode cache file %s with invalid image size",
+        path.c_str());
+    return std::nullopt;
+  }
+
+  // Copy the pixels out of the mapping into memory allocated the way
+  // `stb_image` allocates, so the image can outlive the file.
+  DecodedImage image;
+  image.width = header.width_or_channels;
+  image.height = header.height_or_freq;
+  image.pixels.reset(
+      static_cast<unsigned char*>(std::malloc(header.payload_size)));
+
+  if (image.pixels == nullptr) {
+    return std::nullopt;
+  }
+
+  std::memcpy(
+      image.pixels.get(),
+      file->bytes().data() + sizeof(header),
+      header.payload_size);
+
+  return image;
+}
+
+bool DecodeCache::store_image(
+    std::span<const unsigned char> source,
+    const DecodedImage& image) const {
+  SDL_assert(image.pixels != nullptr);
+
+  const EntryTarget target{
+      .kind = static_cast<uint32_t>(DecodeCacheKind::Image),
+      .format = SDL_PIXELFORMAT_RGBA32,
+  };
+
+  DecodeCacheHeader header;
+  std::memcpy(header.magic, kDecodeCacheMagic, sizeof(kDecodeCacheMagic));
+  header.version = kDecodeCacheVersion;
+  header.key = entry_key(source, target);
+  header.source_size = source.size();
+  header.kind = target.kind;
+  header.format = target.format;
+  header.width_or_channels = image.width;
+  header.height_or_freq = image.height;
+  header.payload_size = kBytesPerPixel * image.width * image.height;
+
+  return write_entry(header, {image.pixels.get(), header.payload_size});
+}
+
+std::unique_ptr<SdlAudioBuffer> DecodeCache::find_audio(
+    std::span<const unsigned char> source,
+    const SDL_AudioSpec& spec) const {
+  const EntryTarget target{
+      .kind = static_cast<uint32_t>(DecodeCacheKind::Audio),
+      .format = static_cast<uint32_t>(spec.format),
+      .channels = spec.channels,
+      .freq = spec.freq,
+  };
+
+  const auto key = entry_key(source, target);
+  const auto path = entry_path(key);
+  DecodeCacheHeader header;
+  const auto file = open_entry(path, key, source, target, header);
+
+  if (file == nullptr) {
+    return nullptr;
+  }
+
+  if (header.width_or_channels != spec.channels ||
+      header.height_or_freq != spec.freq ||
+      header.payload_size > std::numeric_limits<uint32_t>::max()) {
+    SDL_LogWarn(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "ignoring decode cache file %s with invalid audio spec",
+        path.c_str());
+    return nullptr;
+  }
+
+  auto buffer = std::make_unique<SdlAudioBuffer>();
+  buffer->spec = spec;
+  buffer->size_in_bytes = static_cast<uint32_t>(header.payload_size);
+  buffer->data = static_cast<uint8_t*>(SDL_malloc(header.payload_size));
+
+  if (buffer->data == nullptr && header.payload_size > 0) {
+    return nullptr;
+  }
+
+  std::memcpy(
+      buffer->data,
+      file->bytes().data() + sizeof(header),
+      header.payload_size);
+
+  return buffer;
+}
+
+bool DecodeCache::store_audio(
+    std::span<const unsigned char> source,
+    const SdlAudioBuffer& buffer) const {
+  const EntryTarget target{
+      .kind = static_cast<uint32_t>(DecodeCacheKind::Audio),
+      .format = static_cast<uint32_t>(buffer.spec.format),
+      .channels = buffer.spec.channels,
+      .freq = buffer.spec.freq,
+  };
+
+  DecodeCacheHeader header;
+  std::memcpy(header.magic, kDecodeCacheMagic, sizeof(kDecodeCacheMagic));
+  header.version = kDecodeCacheVersion;
+  header.key = entry_key(source, target);
+  header.source_size = source.size();
+  header.kind = target.kind;
+  header.format = target.format;
+  header.width_or_channels = target.channels;
+  header.height_or_freq = target.freq;
+  header.payload_size = buffer.size_in_bytes;
+
+  return write_entry(header, {buffer.data, buffer.size_in_bytes});
+}
+
+size_t DecodeCache::trim() const {
+  const std::lock_guard lock(trim_mutex_);
+
+  int count = 0;
+  char** names = SDL_GlobDirectory(directory_.c_str(), "*.fdac", 0, &count);
+
+  if (names == nullptr) {
+    SDL_LogWarn(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "failed to list decode cache directory %s: %s",
+        directory_.c_str(),
+        SDL_GetError());
+    return 0;
+  }
+
+  struct CacheFile {
+    std::string path;
+    uint64_t size = 0;
+    SDL_Time modify_time = 0;
+  };
+
+  std::vector<CacheFile> files;
+  files.reserve(count);
+  uint64_t size_used = 0;
+
+  for (int i = 0; i < count; ++i) {
+    auto path = directory_ + names[i];
+    SDL_PathInfo info;
+
+    if (SDL_GetPathInfo(path.c_str(), &info)) {
+      files.push_back({std::move(path), info.size, info.modify_time});
+      size_used += info.size;
+    }
+  }
+
+  SDL_free(names);
+
+  size_t removed = 0;
+
+  if (size_used > size_limit_) {
+    std::ranges::sort(files, {}, &CacheFile::modify_time);
+
+    for (const auto& file : files) {
+      if (size_used <= size_limit_ / 4 * 3) {
+        break;
+      }
+
+      // Another process may have deleted or replaced the file, which only
+      // makes the size used an overestimate until the next trim.
+      if (SDL_RemovePath(file.path.c_str())) {
+        size_used -= file.size;
+        ++removed;
+      }
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "deleted %zu decode cache files, %" SDL_PRIu64 " bytes remain",
+        removed,
+        size_used);
+  }
+
+  size_used_.store(size_used, std::memory_order_relaxed);
+  return removed;
+}
+
+std::string DecodeCache::entry_path(uint64_t key) const {
+  return std::format("{}{:016x}.fdac", directory_, key);
+}
+
+bool DecodeCache::write_entry(
+    const DecodeCacheHeader& header,
+    std::span<const unsigned char> payload) const {
+  const auto path = entry_path(header.key);
+
+  // Write to a file only this thread uses, then rename it over the entry so
+  // that concurrent readers and writers never see a partial file.
+  const auto temp_path = std::format(
+      "{}.{:x}.tmp",
+      path,
+      std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+  std::unique_ptr<SDL_IOStream, SdlIoCloser> io{
+      SDL_IOFromFile(temp_path.c_str(), "wb")};
+
+  if (io == nullptr) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "failed to create decode cache file %s: %s",
+        temp_path.c_str(),
+        SDL_GetError());
+    return false;
+  }
+
+  const auto written = SDL_WriteIO(io.get(), &header, sizeof(header)) ==
+                           sizeof(header) &&
+                       SDL_WriteIO(io.get(), payload.data(), payload.size()) ==
+                           payload.size();
+
+  // Close explicitly since closing flushes, and can fail.
+  const auto closed = SDL_CloseIO(io.release());
+
+  if (!written || !closed ||
+      !SDL_RenamePath(temp_path.c_str(), path.c_str())) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "failed to write decode cache file %s: %s",
+        path.c_str(),
+        SDL_GetError());
+
+    SDL_RemovePath(temp_path.c_str());
+    return false;
+  }
+
+  const auto size = sizeof(header) + payload.size();
+
+  if (size_used_.fetch_add(size, std::memory_order_relaxed) + size >
+      size_limit_) {
+    trim();
+  }
+
+  return true;
+}
@@ -0,0 +1,36 @@
+#include <forge/fast_math.h>
+
+#include "support/simd.h"
+#include "support/simd_math.h"
+
+#include <SDL3/SDL.h>
+
+float fast_sin(const float x) { return simd_sin(x); }
+
+float fast_cos(const float x) { return simd_cos(x); }
+
+void fast_sin(const std::span<const float> x, const std::span<float> out) {
+  SDL_assert(out.size() >= x.size());
+  size_t i = 0;
+
+  for (; i + kSimdWidth <= x.size(); i += kSimdWidth) {
+    simd_store(out.data() + i, simd_sin(simd_load(x.data() + i)));
+  }
+
+  for (; i < x.size(); ++i) {
+    out[i] = simd_sin(x[i]);
+  }
+}
+
+void fast_cos(const std::span<const float> x, const std::span<float> out) {
+  SDL_assert(out.size() >= x.size());
+  size_t i = 0;
+
+  for (; i + kSimdWidth <= x.size(); i += kSimdWidth) {
+    simd_store(out.data() + i, simd_cos(simd_load(x.data() + i)));
+  }
+
+  for (; i < x.size(); ++i) {
+    out[i] = simd_cos(x[i]);
+  }
+}
@@ -0,0 +1,91 @@
+#include <forge/frame_arena.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t block_size) {
+  add_block(std::max<size_t>(block_size, 1));
+}
+
+void* FrameArena::allocate(size_t size_in_bytes, size_t alignment) {
+  SDL_assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  // Align the address rather than the offset, since blocks are only aligned to
+  // the default new alignment.
+  const auto align_offset = [alignment](const Block& block, size_t offset) {
+    const auto address =
+        reinterpret_cast<uintptr_t>(block.data.get()) + offset;
+    const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+
+    return offset + (aligned - address);
+  };
+
+  auto start = align_offset(blocks_.back(), offset_);
+
+  // Start a new block when this one is full. The block is made large enough
+  // for the allocation even if it is bigger than the usual block size.
+  if (start + size_in_bytes > blocks_.back().size) {
+    add_block(std::max(blocks_.front().size, size_in_bytes + alignment - 1));
+    start = align_offset(blocks_.back(), 0);
+  }
+
+  bytes_used_ += start - offset_ + size_in_bytes;
+  offset_ = start + size_in_bytes;
+
+  return blocks_.back().data.get() + start;
+}
+
+void FrameArena::reset() {
+  high_water_mark_ = std::max(high_water_mark_, bytes_used_);
+
+  // Replace multiple blocks with one block big enough for everything, so the
+  // next frame of the same size fits without adding blocks.
+  if (blocks_.size() > 1) {
+    const auto total_size = capacity();
+
+    blocks_.clear();
+    add_block(total_size);
+  }
+
+  offset_ = 0;
+  bytes_used_ = 0;
+}
+
+size_t FrameArena::capacity() const {
+  size_t total_size = 0;
+
+  for (const auto& block : blocks_) {
+    total_size += block.size;
+  }
+
+  return total_size;
+}
+
+size_t FrameArena::high_water_mark() const {
+  return std::max(high_water_mark_, bytes_used_);
+}
+
+void FrameArena::add_block(size_t size) {
+  blocks_.push_back(Block{
+      .data = std::make_unique_for_overwrite<std::byte[]>(size),
+      .size = size,
+  });
+
+  offset_ = 0;
+}
+
+void* FrameArenaResource::do_allocate(size_t bytes, size_t alignment) {
+  return arena_.allocate(bytes, alignment);
+}
+
+void FrameArenaResource::do_deallocate(
+    void* /*p*/,
+    size_t /*bytes*/,
+    size_t /*alignment*/) {}
+
+bool FrameArenaResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
@@ -0,0 +1,213 @@
+#include <forge/frame_profiler.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+constexpr double kNsPerMs = 1'000'000.0;
+
+void TimingHistogram::record(uint64_t duration_ns) {
+  buckets_[bucket_index(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_ns_.fetch_add(duration_ns, std::memory_order_relaxed);
+
+  auto min_ns = min_ns_.load(std::memory_order_relaxed);
+
+  while (duration_ns < min_ns &&
+         !min_ns_.compare_exchange_weak(
+             min_ns,
+             duration_ns,
+             std::memory_order_relaxed)) {
+  }
+
+  auto max_ns = max_ns_.load(std::memory_order_relaxed);
+
+  while (duration_ns > max_ns &&
+         !max_ns_.compare_exchange_weak(
+             max_ns,
+             duration_ns,
+             std::memory_order_relaxed)) {
+  }
+}
+
+void TimingHistogram::reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+
+  count_.store(0, std::memory_order_relaxed);
+  total_ns_.store(0, std::memory_order_relaxed);
+  min_ns_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_ns_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t TimingHistogram::percentile_ns(double fraction) const {
+  // Sum the buckets up front rather than trusting `count_`, since the two can
+  // disagree while another thread is recording.
+  uint64_t total = 0;
+
+  for (const auto& bucket : buckets_) {
+    total += bucket.load(std::memory_order_relaxed);
+  }
+
+  if (total == 0) {
+    return 0;
+  }
+
+  // Find the bucket holding the requested rank, and report the middle of that
+  // bucket clamped to the range of recorded values.
+  const auto rank = static_cast<uint64_t>(
+      std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(total)));
+  uint64_t seen = 0;
+
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+
+    if (seen >= std::max<uint64_t>(rank, 1)) {
+      const auto lower = bucket_lower_bound(i);
+      const auto upper =
+          i + 1 < kBucketCount ? bucket_lower_bound(i + 1) : lower;
+      const auto middle = lower + (upper - lower) / 2;
+      const auto min_ns = min_ns_.load(std::memory_order_relaxed);
+      const auto max_ns = max_ns_.load(std::memory_order_relaxed);
+
+      return min_ns <= max_ns ? std::clamp(middle, min_ns, max_ns) : middle;
+    }
+  }
+
+  return max_ns_.load(std::memory_order_relaxed);
+}
+
+TimingSummary TimingHistogram::summarize() const {
+  const auto count = count_.load(std::memory_order_relaxed);
+
+  if (count == 0) {
+    return {};
+  }
+
+  return TimingSummary{
+      .count = count,
+      .min_ms = min_ns_.load(std::memory_order_relaxed) / kNsPerMs,
+      .max_ms = max_ns_.load(std::memory_order_relaxed) / kNsPerMs,
+      .average_ms = total_ns_.load(std::memory_order_relaxed) / kNsPerMs /
+                    static_cast<double>(count),
+      .p50_ms = percentile_ns(0.50) / kNsPerMs,
+      .p95_ms = percentile_ns(0.95) / kNsPerMs,
+      .p99_ms = percentile_ns(0.99) / kNsPerMs,
+  };
+}
+
+size_t TimingHistogram::bucket_index(uint64_t duration_ns) {
+  // Small durations get one bucket each. Past that, the position of the
+  // highest set bit picks the power of two and the next `kSubBucketBits` bits
+  // pick the sub-bucket.
+  if (duration_ns < kSubBucketCount) {
+    return static_cast<size_t>(duration_ns);
+  }
+
+  const unsigned exponent = std::bit_width(duration_ns) - 1;
+
+  if (exponent >= kMaxExponent) {
+    return kBucketCount - 1;
+  }
+
+  const auto sub_bucket =
+      (duration_ns >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1);
+
+  return (exponent - kSubBucketBits + 1) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t TimingHistogram::bucket_lower_bound(size_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+
+  const auto exponent = index / kSubBucketCount - 1 + kSubBucketBits;
+  const auto sub_bucket = index % kSubBucketCount;
+
+  return (kSubBucketCount + sub_bucket) << (exponent - kSubBucketBits);
+}
+
+FrameProfiler::FrameProfiler(double report_interval_s)
+    : window_start_(now()) {
+  const auto ticks_per_second =
+      static_cast<double>(SDL_GetPerformanceFrequency());
+
+  report_interval_ticks_ =
+      static_cast<uint64_t>(report_interval_s * ticks_per_second);
+  ns_per_tick_ = 1e9 / ticks_per_second;
+}
+
+uint64_t FrameProfiler::now() {
+  return SDL_GetPerformanceCounter();
+}
+
+void FrameProfiler::record(FramePhase phase, uint64_t start, uint64_t end) {
+  const auto elapsed_ticks = end > start ? end - start : 0;
+
+  histograms_[static_cast<size_t>(phase)].record(
+      static_cast<uint64_t>(elapsed_ticks * ns_per_tick_));
+}
+
+bool FrameProfiler::end_frame() {
+  const auto current_time = now();
+  const auto elapsed_ticks = current_time - window_start_;
+
+  if (elapsed_ticks < report_interval_ticks_) {
+    return false;
+  }
+
+  // Publish the finished window and start the next one.
+  for (size_t i = 0; i < kFramePhaseCount; ++i) {
+    report_.phases[i] = histograms_[i].summarize();
+    histograms_[i].reset();
+  }
+
+  report_.window_s = elapsed_ticks * ns_per_tick_ / 1e9;
+  window_start_ = current_time;
+
+  if (logging_enabled_) {
+    log_report();
+  }
+
+  return true;
+}
+
+TimingSummary FrameProfiler::current(FramePhase phase) const {
+  return histograms_[static_cast<size_t>(phase)].summarize();
+}
+
+void FrameProfiler::log_report() const {
+  const auto& frame = report_[FramePhase::Frame];
+  const auto& upload = report_[FramePhase::Upload];
+  const auto& input = report_[FramePhase::Input];
+  const auto& update = report_[FramePhase::Update];
+  const auto& render = report_[FramePhase::Render];
+
+  SDL_LogMessage(
+      SDL_LOG_CATEGORY_APPLICATION,
+      SDL_LOG_PRIORITY_INFO,
+      "frame %.1f/s p50 %.2f p95 %.2f p99 %.2f max %.2f ms | "
+      "upload avg %.2f max %.2f ms | "
+      "input avg %.2f max %.2f ms | "
+      "update %.1f/s avg %.2f p99 %.2f max %.2f ms | "
+      "render avg %.2f p99 %.2f max %.2f ms",
+      report_.calls_per_second(FramePhase::Frame),
+      frame.p50_ms,
+      frame.p95_ms,
+      frame.p99_ms,
+      frame.max_ms,
+      upload.average_ms,
+      upload.max_ms,
+      input.average_ms,
+      input.max_ms,
+      report_.calls_per_second(FramePhase::Update),
+      update.average_ms,
+      update.p99_ms,
+      update.max_ms,
+      render.average_ms,
+      render.p99_ms,
+      render.max_ms);
+}
@@ -1,10 +1,22 @@
 #include "forge/audio_manager.h"
 
+#include <forge/async_content_loader.h>
+#include <forge/content.h>
+#include <forge/content_cache.h>
 #include <forge/game.h>
+#include <forge/job_system.h>
+#include <forge/log.h>
+#include <forge/texture_atlas.h>
 
 #include <forge/support/sdl_support.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <format>
+#include <thread>
+
+/// Scaled lag of one update. See `plan_catch_up`.
+constexpr Uint64 kScaledLagPerUpdate = SDL_NS_PER_SECOND;
 
 Game::Game(
     unique_sdl_renderer_ptr renderer,
@@ -12,9 +24,22 @@ Game::Game(
     : renderer_(std::move(renderer)),
       window_(std::move(window)) {}
 
-Game::~Game() = default;
+Game::~Game() {
+  // The mixer reads sounds straight from their buffers, many of which are
+  // owned by `content_cache_`, so stop every sound before any member is freed.
+  if (audio_ != nullptr) {
+    audio_->stop_all_sounds();
+  }
+
+  // Write any queued messages before the game is torn down. Anything logged
+  // during destruction is written immediately.
+  stop_async_logging();
+}
 
 SDL_AppResult Game::init() {
+  // Move log formatting and output off of the game loop's threads.
+  start_async_logging();
+
   // Print start up information to assist with troubleshooting.
   SDL_LogMessage(
       SDL_LOG_CATEGORY_APPLICATION,
@@ -22,7 +47,41 @@ SDL_AppResult Game::init() {
       "app base path is %s",
       SDL_GetBasePath());
 
+  // Read game content from the packed archive when the build produced one,
+  // otherwise load loose files from the content directory.
+  const auto archive_path =
+      std::format("{}{}", SDL_GetBasePath(), kContentArchiveFilename);
+
+  if (SDL_GetPathInfo(archive_path.c_str(), nullptr)) {
+    mount_content_archive(kContentArchiveFilename);
+  }
+
+  // Keep decoded images and audio in the user's preference directory so that
+  // warm starts skip decoding them.
+  if (auto* pref_path =
+          SDL_GetPrefPath(kPrefPathOrganization, kPrefPathApplication);
+      pref_path != nullptr) {
+    enable_decode_cache(std::format("{}decode_cache/", pref_path));
+    SDL_free(pref_path);
+  }
+
+  // Split the hardware threads between the content loader and the job system
+  // rather than letting each start a thread per core. The main thread keeps
+  // one, the loader gets a quarter of the rest and the job system gets what is
+  // left. Both always get at least one worker.
+  const size_t thread_count =
+      std::max(2u, std::thread::hardware_concurrency());
+  const auto loader_worker_count = std::max<size_t>(1, (thread_count - 1) / 4);
+  const auto job_worker_count =
+      std::max<size_t>(1, thread_count - 1 - loader_worker_count);
+
   // Initialize subsystems.
+  content_cache_ = std::make_unique<ContentCache>(renderer_.get());
+  content_loader_ = std::make_unique<AsyncContentLoader>(
+      loader_worker_count,
+      content_cache_.get());
+  texture_atlas_ = std::make_unique<TextureAtlas>();
+  jobs_ = std::make_unique<JobSystem>(job_worker_count);
   audio_ = std::make_unique<AudioManager>();
 
   if (const auto audio_init_status = audio_->init();
@@ -36,14 +95,24 @@ SDL_AppResult Game::init() {
 
   SDL_GetWindowSize(window_.get(), &width, &height);
   SDL_GetWindowSizeInPixels(window_.get(), &pixel_width_, &pixel_height_);
+  pixel_density_ = SDL_GetWindowPixelDensity(window_.get());
 
-  SDL_Log("Window size: %ix%i", width, height);
-  SDL_Log("Back buffer size: %ix%i", pixel_width_, pixel_height_);
+  FORGE_LOG_INFO(
+      SDL_LOG_CATEGORY_APPLICATION,
+      "Window size: %ix%i",
+      width,
+      height);
+  FORGE_LOG_INFO(
+      SDL_LOG_CATEGORY_APPLICATION,
+      "Back buffer size: %ix%i",
+      pixel_width_,
+      pixel_height_);
 
   if (width != pixel_width_) {
-    SDL_Log(
+    FORGE_LOG_INFO(
+        SDL_LOG_CATEGORY_APPLICATION,
         "High DPI environment detected, pixel density = %f",
-        SDL_GetWindowPixelDensity(window_.get()));
+        pixel_density_);
   }
 
   // Initialize the actual game.
@@ -53,18 +122,26 @@ SDL_AppResult Game::init() {
 SDL_AppResult Game::handle_event(const SDL_Event* event) {
   SDL_assert(event != nullptr);
 
+  // Input is queued here and handed to the game in one batch by `iterate`, so
+  // handling an event only costs a few stores.
   switch (event->type) { // NOLINT
     case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED: {
       pixel_width_ = event->window.data1;
       pixel_height_ = event->window.data2;
 
-      SDL_Log(
+      // The pixel density only changes along with the pixel size, so cache it
+      // rather than asking SDL for it on every click.
+      pixel_density_ = SDL_GetWindowPixelDensity(window_.get());
+
+      FORGE_LOG_DEBUG(
+          SDL_LOG_CATEGORY_APPLICATION,
           "Game::handle_event SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED, w = %d, h = "
           "%d",
           pixel_width_,
           pixel_height_);
 
-      return on_render_resized(pixel_width_, pixel_height_);
+      input_queue_.push_resize(pixel_width_, pixel_height_);
+      break;
     }
     case SDL_EVENT_FINGER_DOWN: {
       // Reject out of bounds touches.
@@ -79,27 +156,20 @@ SDL_AppResult Game::handle_event(const SDL_Event* event) {
       const auto touch_x = static_cast<int>(event->tfinger.x * pixel_width());
       const auto touch_y = static_cast<int>(event->tfinger.y * pixel_height());
 
-      SDL_Log(
-          "Game::handle_event SDL_EVENT_FINGER_DOWN, x = %d, y = %d",
-          touch_x,
-          touch_y);
-
-      return on_touch_finger_down(touch_x, touch_y);
+      input_queue_.push_pointer(PointerEventType::TouchDown, touch_x, touch_y);
+      break;
     }
     case SDL_EVENT_MOUSE_BUTTON_UP: {
-      const auto pixel_density = SDL_GetWindowPixelDensity(window_.get());
-      const auto mouse_x = static_cast<int>(event->button.x * pixel_density);
-      const auto mouse_y = static_cast<int>(event->button.y * pixel_density);
-
-      SDL_Log(
-          "Game::handle_event SDL_EVENT_MOUSE_BUTTON_UP, x = %d, y = %d",
-          mouse_x,
-          mouse_y);
+      const auto mouse_x = static_cast<int>(event->button.x * pixel_density_);
+      const auto mouse_y = static_cast<int>(event->button.y * pixel_density_);
 
-      return on_mouse_click(mouse_x, mouse_y);
+      input_queue_.push_pointer(PointerEventType::MouseClick, mouse_x, mouse_y);
+      break;
     }
     case SDL_EVENT_QUIT:
-      SDL_Log("Game::handle_event SDL_EVENT_QUIT, quit_requested => true");
+      FORGE_LOG_INFO(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "Game::handle_event SDL_EVENT_QUIT, quit_requested => true");
       quit_requested_ = true;
       break;
     default:
@@ -110,49 +180,196 @@ SDL_AppResult Game::handle_event(const SDL_Event* event) {
 }
 
 SDL_AppResult Game::iterate() {
-  // TODO: Handle debugger or other excessively long pauses
+  const auto frame_start = FrameProfiler::now();
+
+  // Release the previous frame's transient allocations.
+  frame_arena_.reset();
 
   // Measure the amount of time that has elapsed.
   // Ref: https://gameprogrammingpatterns.com/game-loop.html
-  const auto current_time_ms = SDL_GetTicks();
-  const auto elapsed_time_ms =
-      (previous_time_ms_ > 0 ? current_time_ms - previous_time_ms_ : 0);
+  const auto current_time_ns = clock_ns_ ? clock_ns_() : SDL_GetTicksNS();
+  auto elapsed_time_ns =
+      (previous_time_ns_ > 0 ? current_time_ns - previous_time_ns_ : 0);
+
+  previous_time_ns_ = current_time_ns;
+
+  // Limit how many updates this frame will run. Without a limit a long stall
+  // such as a debugger pause or a slow disk read is followed by hundreds of
+  // updates, which take long enough to cause the next stall.
+  const auto plan = plan_catch_up(
+      scaled_lag_,
+      elapsed_time_ns,
+      update_rate_hz_,
+      max_updates_per_frame_,
+      catch_up_policy_);
+
+  scaled_lag_ = plan.scaled_lag;
+
+  loop_stats_.frames++;
+  loop_stats_.max_updates_owed =
+      std::max(loop_stats_.max_updates_owed, plan.updates_owed);
+
+  if (plan.updates_owed > max_updates_per_frame_) {
+    loop_stats_.overruns++;
+    loop_stats_.dropped_updates += plan.dropped_updates;
+    loop_stats_.clamped_time_ns += plan.clamped_time_ns;
+
+    FORGE_LOG_DEBUG(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "Game::iterate owed %" SDL_PRIu64 " updates, dropped %" SDL_PRIu64
+        ", clamped %" SDL_PRIu64 " ns",
+        plan.updates_owed,
+        plan.dropped_updates,
+        plan.clamped_time_ns);
+  }
+
+  const float delta_s =
+      static_cast<float>(plan.elapsed_time_ns) / SDL_NS_PER_SECOND;
+
+  // Create textures for any images the content loader finished decoding, and
+  // copy new atlas images into their pages. Both are created by `init`, which
+  // tests of the game loop skip.
+  const auto upload_start = FrameProfiler::now();
+
+  if (content_loader_ != nullptr) {
+    content_loader_->process_uploads(renderer_.get());
+  }
+
+  if (texture_atlas_ != nullptr && !texture_atlas_->upload(renderer_.get())) {
+    SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "Game texture atlas upload failed");
+    return SDL_APP_FAILURE;
+  }
 
-  previous_time_ms_ = current_time_ms;
-  lag_time_ms_ += elapsed_time_ms;
+  const auto input_start = FrameProfiler::now();
+  profiler_.record(FramePhase::Upload, upload_start, input_start);
 
-  const float delta_s = elapsed_time_ms / 1000.f;
+  // Process input prior to updating the simulation or rendering. Only the
+  // last resize since the previous frame is reported.
+  if (const auto& resize = input_queue_.pending_resize(); resize) {
+    if (on_render_resized(resize->width, resize->height) == SDL_APP_FAILURE) {
+      SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "Game resize failed");
+      return SDL_APP_FAILURE;
+    }
+  }
+
+  const auto input_result = on_input(delta_s, input_queue_.pointer_events());
+  input_queue_.clear();
 
-  // Process input prior to updating the simulation or rendering.
-  if (on_input(delta_s) == SDL_APP_FAILURE) {
+  if (input_result == SDL_APP_FAILURE) {
     SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "Game input failed");
     return SDL_APP_FAILURE;
   }
 
+  profiler_.record(FramePhase::Input, input_start, FrameProfiler::now());
+
   // Advance the simulation by running as many fixed time steps as required to
-  // get `lag_time_ms_` lower than amount of delta time between logic updates.
-  // TODO: Detect when sim updates exceed the allowed delta time.
-  while (lag_time_ms_ >= kMsPerUpdate) {
-    if (on_update(kMsPerUpdate / 1000.f) == SDL_APP_FAILURE) {
+  // get `scaled_lag_` lower than one update, up to the per frame limit.
+  const auto update_delta_s = this->update_delta_s();
+
+  for (Uint64 update = 0;
+       update < max_updates_per_frame_ && scaled_lag_ >= kScaledLagPerUpdate;
+       ++update) {
+    const auto update_start = FrameProfiler::now();
+
+    if (on_update(update_delta_s) == SDL_APP_FAILURE) {
       SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "Game iteration failed");
       return SDL_APP_FAILURE;
     }
 
-    lag_time_ms_ -= kMsPerUpdate;
+    profiler_.record(FramePhase::Update, update_start, FrameProfiler::now());
+    scaled_lag_ -= kScaledLagPerUpdate;
+    loop_stats_.updates++;
   }
 
   // Render the game.
   // TODO: Detect when the renderer exceeds the allowed delta time.
-  on_render(delta_s, lag_time_ms_ / static_cast<float>(kMsPerUpdate));
+  const auto render_start = FrameProfiler::now();
+  // Only the partial update is extrapolated. Whole updates still owed while
+  // catching up in slow motion are run by later frames instead.
+  on_render(
+      delta_s,
+      static_cast<float>(scaled_lag_ % kScaledLagPerUpdate) /
+          kScaledLagPerUpdate);
+
+  const auto frame_end = FrameProfiler::now();
+  profiler_.record(FramePhase::Render, render_start, frame_end);
+  profiler_.record(FramePhase::Frame, frame_start, frame_end);
+  profiler_.end_frame();
 
   // Check if the user wants to continue running the game or if it's time to
   // quit.
   return quit_requested_ ? SDL_APP_SUCCESS : SDL_APP_CONTINUE;
 }
 
+void Game::set_update_rate(Uint32 rate_hz) {
+  rate_hz = std::max<Uint32>(rate_hz, 1);
+
+  // Rescale the lag so the time owed to the simulation is unchanged. Multiply
+  // first so no fraction of a nanosecond is lost. The lag is at most a few
+  // updates, so this cannot overflow.
+  scaled_lag_ = scaled_lag_ * rate_hz / update_rate_hz_;
+  update_rate_hz_ = rate_hz;
+}
+
+CatchUpPlan plan_catch_up(
+    Uint64 scaled_lag,
+    Uint64 elapsed_time_ns,
+    Uint32 update_rate_hz,
+    Uint64 max_updates_per_frame,
+    CatchUpPolicy policy) {
+  CatchUpPlan plan;
+  plan.scaled_lag = scaled_lag + elapsed_time_ns * update_rate_hz;
+  plan.updates_owed = plan.scaled_lag / kScaledLagPerUpdate;
+  plan.elapsed_time_ns = elapsed_time_ns;
+
+  if (plan.updates_owed <= max_updates_per_frame) {
+    return plan;
+  }
+
+  switch (policy) {
+    case CatchUpPolicy::Clamp: {
+      // Shorten the frame so the lag is exactly the most updates allowed.
+      const auto max_scaled_lag = max_updates_per_frame * kScaledLagPerUpdate;
+      const auto clamped_scaled_lag = plan.scaled_lag - max_scaled_lag;
+
+      plan.clamped_time_ns =
+          std::min(elapsed_time_ns, clamped_scaled_lag / update_rate_hz);
+      plan.elapsed_time_ns -= plan.clamped_time_ns;
+      plan.scaled_lag = max_scaled_lag;
+      break;
+    }
+    case CatchUpPolicy::Drop:
+      plan.dropped_updates = plan.updates_owed - max_updates_per_frame;
+      break;
+    case CatchUpPolicy::SlowMotion:
+      // Keep up to another frame's worth of updates for later frames.
+      plan.dropped_updates =
+          plan.updates_owed -
+          std::min(plan.updates_owed, 2 * max_updates_per_frame);
+      break;
+  }
+
+  plan.scaled_lag -= plan.dropped_updates * kScaledLagPerUpdate;
+  return plan;
+}
+
 SDL_AppResult Game::on_init() { return SDL_APP_CONTINUE; }
 
-SDL_AppResult Game::on_input(float /*delta_s*/) { return SDL_APP_CONTINUE; }
+SDL_AppResult Game::on_input(
+    float /*delta_s*/,
+    std::span<const PointerEvent> pointer_events) {
+  for (const auto& pointer : pointer_events) {
+    const auto result = pointer.type == PointerEventType::MouseClick
+                            ? on_mouse_click(pointer.x, pointer.y)
+                            : on_touch_finger_down(pointer.x, pointer.y);
+
+    if (result == SDL_APP_FAILURE) {
+      return SDL_APP_FAILURE;
+    }
+  }
+
+  return SDL_APP_CONTINUE;
+}
 
 SDL_AppResult Game::on_update(float /*delta_s*/) { return SDL_APP_CONTINUE; }
 
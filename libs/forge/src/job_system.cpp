@@ -0,0 +1,195 @@
+#include <forge/job_system.h>
+
+#include <SDL3/SDL.h>
+
+/// The job system and queue owned by the current thread, if it is a worker.
+static thread_local JobSystem* GWorkerJobSystem = nullptr;
+static thread_local size_t GWorkerQueueIndex = 0;
+
+JobSystem::JobSystem(size_t worker_count) {
+  if (worker_count == 0) {
+    worker_count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+  }
+
+  // One queue per worker, plus the shared queue at the end.
+  for (size_t i = 0; i < worker_count + 1; ++i) {
+    queues_.push_back(std::make_unique<JobQueue>());
+  }
+
+  workers_.reserve(worker_count);
+
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back([this, i] { worker_main(i); });
+  }
+
+  SDL_LogMessage(
+      SDL_LOG_CATEGORY_APPLICATION,
+      SDL_LOG_PRIORITY_DEBUG,
+      "started job system with %d worker threads",
+      static_cast<int>(worker_count));
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    stopping_ = true;
+  }
+
+  sleep_cv_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void JobSystem::run(Job job, JobCounter* counter) {
+  if (counter != nullptr) {
+    counter->pending_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  push(std::move(job), counter);
+}
+
+void JobSystem::run_after(
+    JobCounter& dependency,
+    Job job,
+    JobCounter* counter) {
+  if (counter != nullptr) {
+    counter->pending_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // The lock orders this check against `finish` taking the continuations, so
+  // the job is either queued here or by the last job in the group, never both.
+  {
+    std::lock_guard lock(dependency.continuations_mutex_);
+
+    if (!dependency.done()) {
+      dependency.continuations_.push_back(
+          {.job = std::move(job), .counter = counter});
+      return;
+    }
+  }
+
+  push(std::move(job), counter);
+}
+
+void JobSystem::wait(JobCounter& counter) {
+  const auto queue_index =
+      GWorkerJobSystem == this ? GWorkerQueueIndex : shared_queue_index();
+
+  while (!counter.done()) {
+    if (!try_run_one(queue_index)) {
+      std::this_thread::yield();
+    }
+  }
+
+  // The last job in the group may still hold the counter's lock after the
+  // count reaches zero. Wait for it to let go so the caller can safely destroy
+  // the counter.
+  std::lock_guard lock(counter.continuations_mutex_);
+}
+
+void JobSystem::worker_main(size_t worker_index) {
+  GWorkerJobSystem = this;
+  GWorkerQueueIndex = worker_index;
+
+  while (true) {
+    if (try_run_one(worker_index)) {
+      continue;
+    }
+
+    // Sleep until more jobs are queued.
+    std::unique_lock lock(sleep_mutex_);
+    sleep_cv_.wait(lock, [this] {
+      return stopping_ || queued_count_.load(std::memory_order_acquire) > 0;
+    });
+
+    if (stopping_) {
+      return;
+    }
+  }
+}
+
+void JobSystem::push(Job job, JobCounter* counter) {
+  // Workers queue onto their own queue, and every other thread uses the shared
+  // queue.
+  auto& queue = *queues_[
+      GWorkerJobSystem == this ? GWorkerQueueIndex : shared_queue_index()];
+
+  {
+    std::lock_guard lock(queue.mutex);
+    queue.jobs.emplace_back(std::move(job), counter);
+  }
+
+  queued_count_.fetch_add(1, std::memory_order_release);
+
+  // Taking the sleep lock before notifying ensures a worker that just found no
+  // jobs is either already asleep, or will see the new count before sleeping.
+  { std::lock_guard lock(sleep_mutex_); }
+  sleep_cv_.notify_one();
+}
+
+bool JobSystem::try_run_one(size_t queue_index) {
+  std::pair<Job, JobCounter*> job;
+  bool found = false;
+
+  // Take the newest job from this thread's own queue first.
+  {
+    auto& queue = *queues_[queue_index];
+    std::lock_guard lock(queue.mutex);
+
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+      found = true;
+    }
+  }
+
+  // Otherwise steal the oldest job from another queue, starting with the one
+  // after this thread's own so that thieves spread out.
+  for (size_t i = 1; !found && i < queues_.size(); ++i) {
+    auto& queue = *queues_[(queue_index + i) % queues_.size()];
+    std::lock_guard lock(queue.mutex);
+
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+      found = true;
+    }
+  }
+
+  if (!found) {
+    return false;
+  }
+
+  queued_count_.fetch_sub(1, std::memory_order_relaxed);
+
+  job.first();
+  finish(job.second);
+
+  return true;
+}
+
+void JobSystem::finish(JobCounter* counter) {
+  if (counter == nullptr) {
+    return;
+  }
+
+  // If this was the last job in the group, queue everything waiting on it. The
+  // count is decremented under the lock so that `run_after` and `wait` see a
+  // consistent state, and the counter is not touched after the lock is
+  // released since a waiting thread may destroy it.
+  std::vector<JobCounter::Continuation> continuations;
+
+  {
+    std::lock_guard lock(counter->continuations_mutex_);
+
+    if (counter->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      continuations.swap(counter->continuations_);
+    }
+  }
+
+  for (auto& continuation : continuations) {
+    push(std::move(continuation.job), continuation.counter);
+  }
+}
@@ -0,0 +1,245 @@
+#include <forge/log.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <mutex>
+#include <thread>
+
+static_assert(
+    (kLogQueueCapacity & (kLogQueueCapacity - 1)) == 0,
+    "log queue capacity must be a power of two");
+
+namespace {
+  /// A formatted message waiting in the queue.
+  struct LogSlot {
+    /// Equal to the slot's position when free, and one past the position once
+    /// a producer has finished writing the message.
+    std::atomic<size_t> sequence{0};
+    int category = 0;
+    SDL_LogPriority priority = SDL_LOG_PRIORITY_INFO;
+    char text[kMaxLogMessageLength];
+  };
+
+  /// A bounded multiple producer, single consumer queue of log messages.
+  ///
+  /// Producers claim a slot by advancing `enqueue_position` and format their
+  /// message straight into it, so logging never allocates or takes a lock.
+  /// When the queue is full the message is dropped and counted rather than
+  /// making the producer wait.
+  ///
+  /// The flush thread sleeps on `wake_cv` while the queue is empty. Producers
+  /// only take the mutex to wake it when `sleeping` is set, so a burst of
+  /// messages costs at most one wake up.
+  struct AsyncLog {
+    AsyncLog() {
+      for (size_t i = 0; i < kLogQueueCapacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    std::array<LogSlot, kLogQueueCapacity> slots;
+    alignas(64) std::atomic<size_t> enqueue_position{0};
+    alignas(64) size_t dequeue_position = 0;
+    std::atomic<uint64_t> dropped{0};
+    uint64_t dropped_reported = 0;
+
+    std::atomic<bool> running{false};
+    /// Number of `forge_log` calls that may be writing to the queue. Stopping
+    /// waits for this to reach zero, so no claimed slot is left unpublished.
+    std::atomic<size_t> active_producers{0};
+
+    std::thread flush_thread;
+    std::mutex mutex;
+    std::condition_variable wake_cv;
+    std::atomic<bool> sleeping{false};
+    bool stopping = false;
+  };
+
+  AsyncLog& async_log() {
+    static AsyncLog log;
+    return log;
+  }
+
+  /// Claims a free slot, or returns null if the queue is full.
+  LogSlot* claim_slot(AsyncLog& log, size_t& position) {
+    position = log.enqueue_position.load(std::memory_order_relaxed);
+
+    for (;;) {
+      auto& slot = log.slots[position & (kLogQueueCapacity - 1)];
+      const auto sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<intptr_t>(sequence) -
+                              static_cast<intptr_t>(position);
+
+      if (difference == 0) {
+        if (log.enqueue_position.compare_exchange_weak(
+                position,
+                position + 1,
+                std::memory_order_relaxed)) {
+          return &slot;
+        }
+      } else if (difference < 0) {
+        return nullptr;
+      } else {
+        position = log.enqueue_position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// True if the next message in the queue has been published. Only called by
+  /// the thread that flushes.
+  bool has_message(const AsyncLog& log) {
+    const auto position = log.dequeue_position;
+    const auto& slot = log.slots[position & (kLogQueueCapacity - 1)];
+
+    return slot.sequence.load(std::memory_order_acquire) == position + 1;
+  }
+
+  /// Writes every finished message in the queue. Only called by one thread at
+  /// a time.
+  void flush(AsyncLog& log) {
+    for (;;) {
+      const auto position = log.dequeue_position;
+      auto& slot = log.slots[position & (kLogQueueCapacity - 1)];
+
+      if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+        break;
+      }
+
+      SDL_LogMessage(slot.category, slot.priority, "%s", slot.text);
+
+      slot.sequence.store(
+          position + kLogQueueCapacity,
+          std::memory_order_release);
+      log.dequeue_position = position + 1;
+    }
+
+    const auto dropped = log.dropped.load(std::memory_order_relaxed);
+
+    if (dropped != log.dropped_reported) {
+      SDL_LogMessage(
+          SDL_LOG_CATEGORY_APPLICATION,
+          SDL_LOG_PRIORITY_WARN,
+          "log queue was full, dropped %" SDL_PRIu64 " messages",
+          dropped - log.dropped_reported);
+      log.dropped_reported = dropped;
+    }
+  }
+
+  void flush_thread_main(AsyncLog& log) {
+    std::unique_lock lock(log.mutex);
+
+    while (!log.stopping) {
+      lock.unlock();
+      flush(log);
+      lock.lock();
+
+      // Announce the thread is going to sleep before checking the queue one
+      // last time. A producer either published before the check, or sees
+      // `sleeping` after publishing and wakes the thread.
+      log.sleeping.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      log.wake_cv.wait(lock, [&] { return log.stopping || has_message(log); });
+      log.sleeping.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  /// Wakes the flush thread if it is waiting for a message.
+  void wake_flush_thread(AsyncLog& log) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (log.sleeping.load(std::memory_order_relaxed)) {
+      // Holding the mutex means the thread is either waiting and will be
+      // notified, or has not started waiting and will see the message.
+      std::lock_guard lock(log.mutex);
+      log.wake_cv.notify_one();
+    }
+  }
+} // namespace
+
+void forge_log(
+    int category,
+    SDL_LogPriority priority,
+    const char* format,
+    ...) {
+  auto& log = async_log();
+
+  va_list args;
+  va_start(args, format);
+
+  // Count this call as a producer before checking `running`, so that
+  // `stop_async_logging` either sees it and waits, or this call sees the log
+  // has stopped.
+  log.active_producers.fetch_add(1, std::memory_order_seq_cst);
+
+  if (!log.running.load(std::memory_order_seq_cst)) {
+    log.active_producers.fetch_sub(1, std::memory_order_release);
+    SDL_LogMessageV(category, priority, format, args);
+    va_end(args);
+    return;
+  }
+
+  size_t position = 0;
+  auto* slot = claim_slot(log, position);
+
+  if (slot == nullptr) {
+    log.dropped.fetch_add(1, std::memory_order_relaxed);
+    log.active_producers.fetch_sub(1, std::memory_order_release);
+    va_end(args);
+    return;
+  }
+
+  slot->category = category;
+  slot->priority = priority;
+  SDL_vsnprintf(slot->text, sizeof(slot->text), format, args);
+  va_end(args);
+
+  slot->sequence.store(position + 1, std::memory_order_release);
+  wake_flush_thread(log);
+  log.active_producers.fetch_sub(1, std::memory_order_release);
+}
+
+void start_async_logging() {
+  auto& log = async_log();
+
+  if (log.running.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  log.stopping = false;
+  log.flush_thread = std::thread([&log] { flush_thread_main(log); });
+  log.running.store(true, std::memory_order_release);
+}
+
+void stop_async_logging() {
+  auto& log = async_log();
+
+  if (!log.running.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  log.running.store(false, std::memory_order_seq_cst);
+
+  // Wait for producers that saw the log running to publish their messages.
+  // New calls log immediately, so this only waits for a message or two.
+  while (log.active_producers.load(std::memory_order_seq_cst) != 0) {
+    std::this_thread::yield();
+  }
+
+  {
+    std::lock_guard lock(log.mutex);
+    log.stopping = true;
+  }
+
+  log.wake_cv.notify_one();
+  log.flush_thread.join();
+
+  // Write anything queued after the thread's last pass.
+  flush(log);
+}
+
+uint64_t log_dropped_count() {
+  return async_log().dropped.load(std::memory_order_relaxed);
+}
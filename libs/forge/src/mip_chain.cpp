@@ -0,0 +1,219 @@
+#include <forge/mip_chain.h>
+
+#include "support/simd.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+constexpr int kBytesPerPixel = 4; // RGBA
+
+namespace {
+  /// Averages each 2x2 block of pixels taken from rows `top` and `bottom` into
+  /// `out_count` output pixels, rounding to nearest.
+  void downsample_row(
+      const unsigned char* top,
+      const unsigned char* bottom,
+      unsigned char* out,
+      int out_count) {
+    int i = 0;
+
+#if FORGE_SIMD_AVX || FORGE_SIMD_SSE2
+    // Widen to 16 bits so the sum of four pixels cannot overflow, then add
+    // each pixel to its right hand neighbour. Every step turns four input
+    // pixels from each row into two output pixels.
+    const auto zero = _mm_setzero_si128();
+    const auto rounding = _mm_set1_epi16(2);
+
+    const auto average_four = [&](int in_offset) {
+      const auto top_pixels = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(top + in_offset));
+      const auto bottom_pixels = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(bottom + in_offset));
+
+      // Column sums for pixels 0 and 1, and for pixels 2 and 3.
+      const auto left = _mm_add_epi16(
+          _mm_unpacklo_epi8(top_pixels, zero),
+          _mm_unpacklo_epi8(bottom_pixels, zero));
+      const auto right = _mm_add_epi16(
+          _mm_unpackhi_epi8(top_pixels, zero),
+          _mm_unpackhi_epi8(bottom_pixels, zero));
+
+      // Pair pixel 0 with 1 and pixel 2 with 3.
+      const auto sums = _mm_add_epi16(
+          _mm_unpacklo_epi64(left, right),
+          _mm_unpackhi_epi64(left, right));
+
+      return _mm_srli_epi16(_mm_add_epi16(sums, rounding), 2);
+    };
+
+    for (; i + 4 <= out_count; i += 4) {
+      const auto in_offset = i * 2 * kBytesPerPixel;
+      const auto first = average_four(in_offset);
+      const auto second = average_four(in_offset + 4 * kBytesPerPixel);
+
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(out + i * kBytesPerPixel),
+          _mm_packus_epi16(first, second));
+    }
+#elif FORGE_SIMD_NEON
+    // Load eight pixels from each row split into even and odd pixels, then add
+    // the pairs with widening adds and narrow with a rounding shift.
+    for (; i + 4 <= out_count; i += 4) {
+      const auto in_offset = i * 2 * kBytesPerPixel;
+      const auto top_pixels =
+          vld2q_u32(reinterpret_cast<const uint32_t*>(top + in_offset));
+      const auto bottom_pixels =
+          vld2q_u32(reinterpret_cast<const uint32_t*>(bottom + in_offset));
+
+      const auto top_even = vreinterpretq_u8_u32(top_pixels.val[0]);
+      const auto top_odd = vreinterpretq_u8_u32(top_pixels.val[1]);
+      const auto bottom_even = vreinterpretq_u8_u32(bottom_pixels.val[0]);
+      const auto bottom_odd = vreinterpretq_u8_u32(bottom_pixels.val[1]);
+
+      const auto low = vaddq_u16(
+          vaddl_u8(vget_low_u8(top_even), vget_low_u8(top_odd)),
+          vaddl_u8(vget_low_u8(bottom_even), vget_low_u8(bottom_odd)));
+      const auto high = vaddq_u16(
+          vaddl_u8(vget_high_u8(top_even), vget_high_u8(top_odd)),
+          vaddl_u8(vget_high_u8(bottom_even), vget_high_u8(bottom_odd)));
+
+      vst1q_u8(
+          out + i * kBytesPerPixel,
+          vcombine_u8(vrshrn_n_u16(low, 2), vrshrn_n_u16(high, 2)));
+    }
+#endif
+
+    // Finish the pixels left over from the SIMD loop.
+    for (; i < out_count; ++i) {
+      const auto* t = top + i * 2 * kBytesPerPixel;
+      const auto* b = bottom + i * 2 * kBytesPerPixel;
+
+      for (int c = 0; c < kBytesPerPixel; ++c) {
+        const auto sum = t[c] + t[c + kBytesPerPixel] + b[c] +
+                         b[c + kBytesPerPixel] + 2;
+        out[i * kBytesPerPixel + c] = static_cast<unsigned char>(sum >> 2);
+      }
+    }
+  }
+} // namespace
+
+DecodedImage downsample_image(const DecodedImage& image) {
+  if (image.pixels == nullptr || image.width <= 0 || image.height <= 0) {
+    return {};
+  }
+
+  DecodedImage result;
+  result.width = std::max(image.width / 2, 1);
+  result.height = std::max(image.height / 2, 1);
+
+  // `stb_image` allocates with `malloc`, which is what the deleter expects.
+  result.pixels.reset(static_cast<unsigned char*>(std::malloc(
+      static_cast<size_t>(result.width) * result.height * kBytesPerPixel)));
+
+  if (result.pixels == nullptr) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "failed to allocate %dx%d mip level",
+        result.width,
+        result.height);
+    return {};
+  }
+
+  const auto in_pitch = static_cast<size_t>(image.width) * kBytesPerPixel;
+  const auto out_pitch = static_cast<size_t>(result.width) * kBytesPerPixel;
+  const auto* in = image.pixels.get();
+  auto* out = result.pixels.get();
+
+  if (image.width >= 2 && image.height >= 2) {
+    for (int y = 0; y < result.height; ++y) {
+      downsample_row(
+          in + (2 * y) * in_pitch,
+          in + (2 * y + 1) * in_pitch,
+          out + y * out_pitch,
+          result.width);
+    }
+
+    return result;
+  }
+
+  // A single row or column only averages pairs of pixels along its length.
+  const auto step = image.width >= 2 ? kBytesPerPixel : in_pitch;
+  const auto out_count = std::max(result.width, result.height);
+
+  for (int i = 0; i < out_count; ++i) {
+    const auto* first = in + 2 * i * step;
+    const auto* second = image.width * image.height > 1 ? first + step : first;
+
+    for (int c = 0; c < kBytesPerPixel; ++c) {
+      out[i * kBytesPerPixel + c] =
+          static_cast<unsigned char>((first[c] + second[c] + 1) >> 1);
+    }
+  }
+
+  return result;
+}
+
+size_t mip_level_for(
+    int base_width,
+    int base_height,
+    size_t level_count,
+    float dest_width,
+    float dest_height) {
+  SDL_assert(level_count > 0);
+
+  // Step down while the next level is still at least the destination size.
+  size_t level = 0;
+  auto width = base_width;
+  auto height = base_height;
+
+  while (level + 1 < level_count) {
+    const auto next_width = std::max(width / 2, 1);
+    const auto next_height = std::max(height / 2, 1);
+
+    if (next_width < dest_width || next_height < dest_height ||
+        (next_width == width && next_height == height)) {
+      break;
+    }
+
+    width = next_width;
+    height = next_height;
+    level++;
+  }
+
+  return level;
+}
+
+MipChain::MipChain(DecodedImage base, int min_size) {
+  if (base.pixels == nullptr) {
+    return;
+  }
+
+  min_size = std::max(min_size, 1);
+  levels_.push_back(std::move(base));
+
+  while (levels_.back().width / 2 >= min_size &&
+         levels_.back().height / 2 >= min_size) {
+    auto next = downsample_image(levels_.back());
+
+    if (next.pixels == nullptr) {
+      break;
+    }
+
+    levels_.push_back(std::move(next));
+  }
+}
+
+size_t MipChain::level_for(float dest_width, float dest_height) const {
+  if (levels_.empty()) {
+    return 0;
+  }
+
+  return mip_level_for(
+      levels_.front().width,
+      levels_.front().height,
+      levels_.size(),
+      dest_width,
+      dest_height);
+}
@@ -0,0 +1,105 @@
+#include <forge/music_stream.h>
+
+#include <forge/audio_manager.h>
+
+#include <SDL3/SDL.h>
+#include <stb/stb_vorbis.h>
+
+#include <limits>
+
+std::unique_ptr<MusicStream>
+    MusicStream::open(const std::string_view filename, bool loop) {
+  // Keep the compressed file in memory for the lifetime of the stream. This is
+  // a view into the mounted content archive when the archive has the file.
+  auto file = read_content(filename);
+
+  if (file.empty()) {
+    return nullptr;
+  }
+
+  SDL_assert(file.bytes().size() <= std::numeric_limits<int>::max());
+
+  int error = 0;
+  auto vorbis = stb_vorbis_open_memory(
+      file.bytes().data(),
+      static_cast<int>(file.bytes().size()),
+      &error,
+      nullptr);
+
+  if (vorbis == nullptr) {
+    SDL_LogError(
+        FORGE_LOG_CATEGORY_AUDIO,
+        "failed to open ogg music stream %.*s, stb_vorbis error = %d",
+        static_cast<int>(filename.length()),
+        filename.data(),
+        error);
+    return nullptr;
+  }
+
+  // Moving the file does not move its bytes, so the decoder can keep reading
+  // from the same memory.
+  std::unique_ptr<MusicStream> music{
+      new MusicStream(std::move(file), vorbis, loop)};
+
+  SDL_LogDebug(
+      FORGE_LOG_CATEGORY_AUDIO,
+      "opened ogg music stream %.*s with channels = %d, freq = %d",
+      static_cast<int>(filename.length()),
+      filename.data(),
+      music->spec_.channels,
+      music->spec_.freq);
+
+  return music;
+}
+
+MusicStream::MusicStream(ContentBytes file, stb_vorbis* vorbis, bool loop)
+    : file_(std::move(file)),
+      vorbis_(vorbis),
+      loop_(loop) {
+  const auto info = stb_vorbis_get_info(vorbis_);
+
+  spec_ = SDL_AudioSpec{
+      .format = SDL_AUDIO_F32,
+      .channels = info.channels,
+      .freq = static_cast<int>(info.sample_rate),
+  };
+}
+
+MusicStream::~MusicStream() {
+  stb_vorbis_close(vorbis_);
+}
+
+size_t MusicStream::read(std::span<float> samples) {
+  const auto channels = spec_.channels;
+  const auto frames_requested = samples.size() / channels;
+  size_t frames_read = 0;
+  bool rewound = false;
+
+  while (frames_read < frames_requested && !finished()) {
+    const auto remaining = samples.subspan(frames_read * channels);
+    const auto frames = stb_vorbis_get_samples_float_interleaved(
+        vorbis_,
+        channels,
+        remaining.data(),
+        static_cast<int>(remaining.size()));
+
+    // Wrap around to the start when looping, unless the file produced no
+    // samples since the last wrap (an empty file would loop forever).
+    if (frames > 0) {
+      frames_read += static_cast<size_t>(frames);
+      rewound = false;
+    } else if (loop_ && !rewound) {
+      stb_vorbis_seek_start(vorbis_);
+      rewound = true;
+    } else {
+      finished_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  return frames_read;
+}
+
+void MusicStream::rewind() {
+  stb_vorbis_seek_start(vorbis_);
+  finished_.store(false, std::memory_order_relaxed);
+}
@@ -0,0 +1,237 @@
+#include <forge/particle_store.h>
+
+#include <forge/job_system.h>
+
+#include "support/simd.h"
+#include "support/simd_math.h"
+
+#include <SDL3/SDL.h>
+
+void ParticleStore::reserve(size_t capacity) {
+  x_.reserve(capacity);
+  y_.reserve(capacity);
+  previous_x_.reserve(capacity);
+  previous_y_.reserve(capacity);
+  size_.reserve(capacity);
+  speed_.reserve(capacity);
+  wobble_amplitude_.reserve(capacity);
+  wobble_frequency_.reserve(capacity);
+  wobble_phase_.reserve(capacity);
+  dead_indices_.reserve(capacity);
+}
+
+void ParticleStore::clear() {
+  x_.clear();
+  y_.clear();
+  previous_x_.clear();
+  previous_y_.clear();
+  size_.clear();
+  speed_.clear();
+  wobble_amplitude_.clear();
+  wobble_frequency_.clear();
+  wobble_phase_.clear();
+
+  // Drop scratch entries too, since they index particles that no longer exist.
+  dead_indices_.clear();
+
+  for (auto& dead_indices : chunk_dead_indices_) {
+    dead_indices.clear();
+  }
+}
+
+size_t ParticleStore::spawn(const ParticleDesc& desc) {
+  x_.push_back(desc.x);
+  y_.push_back(desc.y);
+  previous_x_.push_back(desc.x);
+  previous_y_.push_back(desc.y);
+  size_.push_back(desc.size);
+  speed_.push_back(desc.speed);
+  wobble_amplitude_.push_back(desc.wobble_amplitude);
+  wobble_frequency_.push_back(desc.wobble_frequency);
+  wobble_phase_.push_back(desc.wobble_phase);
+
+  return x_.size() - 1;
+}
+
+void ParticleStore::swap_remove(size_t index) {
+  SDL_assert(index < size());
+  const auto last = size() - 1;
+
+  x_[index] = x_[last];
+  y_[index] = y_[last];
+  previous_x_[index] = previous_x_[last];
+  previous_y_[index] = previous_y_[last];
+  size_[index] = size_[last];
+  speed_[index] = speed_[last];
+  wobble_amplitude_[index] = wobble_amplitude_[last];
+  wobble_frequency_[index] = wobble_frequency_[last];
+  wobble_phase_[index] = wobble_phase_[last];
+
+  x_.pop_back();
+  y_.pop_back();
+  previous_x_.pop_back();
+  previous_y_.pop_back();
+  size_.pop_back();
+  speed_.pop_back();
+  wobble_amplitude_.pop_back();
+  wobble_frequency_.pop_back();
+  wobble_phase_.pop_back();
+}
+
+size_t ParticleStore::integrate(
+    const float delta_s,
+    const float time_s,
+    const float despawn_y) {
+  dead_indices_.clear();
+  integrate_range(0, size(), delta_s, time_s, despawn_y, dead_indices_);
+  remove_dead();
+
+  return dead_indices_.size();
+}
+
+size_t ParticleStore::integrate(
+    const float delta_s,
+    const float time_s,
+    const float despawn_y,
+    JobSystem& jobs) {
+  const size_t count = size();
+
+  if (count <= kParallelChunkSize) {
+    return integrate(delta_s, time_s, despawn_y);
+  }
+
+  // Each chunk collects its dead particles in its own list. Chunks cover
+  // increasing index ranges, so joining the lists in chunk order keeps the
+  // dead indices sorted.
+  const auto chunk_count =
+      (count + kParallelChunkSize - 1) / kParallelChunkSize;
+
+  if (chunk_dead_indices_.size() < chunk_count) {
+    chunk_dead_indices_.resize(chunk_count);
+  }
+
+  jobs.parallel_for(
+      0,
+      count,
+      kParallelChunkSize,
+      [&](size_t begin, size_t end) {
+        auto& dead_indices = chunk_dead_indices_[begin / kParallelChunkSize];
+        dead_indices.clear();
+        integrate_range(begin, end, delta_s, time_s, despawn_y, dead_indices);
+      });
+
+  dead_indices_.clear();
+
+  for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    dead_indices_.insert(
+        dead_indices_.end(),
+        chunk_dead_indices_[chunk].begin(),
+        chunk_dead_indices_[chunk].end());
+  }
+
+  remove_dead();
+
+  return dead_indices_.size();
+}
+
+void ParticleStore::integrate_range(
+    const size_t begin,
+    const size_t end,
+    const float delta_s,
+    const float time_s,
+    const float despawn_y,
+    std::vector<uint32_t>& dead_indices) {
+  float* const x = x_.data();
+  float* const y = y_.data();
+  float* const previous_x = previous_x_.data();
+  float* const previous_y = previous_y_.data();
+  const float* const size = size_.data();
+  const float* const speed = speed_.data();
+  const float* const amplitude = wobble_amplitude_.data();
+  const float* const frequency = wobble_frequency_.data();
+  const float* const phase = wobble_phase_.data();
+
+  // Move particles `kSimdWidth` at a time, and record any that crossed the
+  // despawn line while their values are still in registers.
+  const auto delta_v = simd_splat(delta_s);
+  const auto time_v = simd_splat(time_s);
+  const auto despawn_v = simd_splat(despawn_y);
+
+  size_t i = begin;
+
+  for (; i + kSimdWidth <= end; i += kSimdWidth) {
+    const auto old_x = simd_load(x + i);
+    const auto old_y = simd_load(y + i);
+    simd_store(previous_x + i, old_x);
+    simd_store(previous_y + i, old_y);
+
+    const auto new_y = old_y + simd_load(speed + i) * delta_v;
+    simd_store(y + i, new_y);
+
+    const auto wobble =
+        simd_sin(simd_load(phase + i) + simd_load(frequency + i) * time_v);
+    simd_store(x + i, old_x + wobble * simd_load(amplitude + i));
+
+    // Collect the lanes that are past the despawn line.
+    auto dead_mask = simd_ge_mask(new_y, despawn_v + simd_load(size + i));
+
+    while (dead_mask != 0) {
+      dead_indices.push_back(
+          static_cast<uint32_t>(i + simd_lowest_lane(dead_mask)));
+      dead_mask &= dead_mask - 1;
+    }
+  }
+
+  // Finish off any particles that did not fill a complete SIMD register.
+  for (; i < end; ++i) {
+    previous_x[i] = x[i];
+    previous_y[i] = y[i];
+    y[i] += speed[i] * delta_s;
+    x[i] += simd_sin(phase[i] + time_s * frequency[i]) * amplitude[i];
+
+    if (y[i] >= despawn_y + size[i]) {
+      dead_indices.push_back(static_cast<uint32_t>(i));
+    }
+  }
+}
+
+void ParticleStore::remove_dead() {
+  // Remove dead particles from highest index to lowest. Any particle swapped
+  // into a removed slot comes from the end of the store, which has already
+  // been checked, so no live particle is skipped and no dead particle survives.
+  for (auto itr = dead_indices_.rbegin(); itr != dead_indices_.rend(); ++itr) {
+    swap_remove(*itr);
+  }
+}
+
+void ParticleStore::interpolate_positions(
+    const float alpha,
+    std::span<float> out_x,
+    std::span<float> out_y) const {
+  const size_t count = size();
+  SDL_assert(out_x.size() >= count && out_y.size() >= count);
+
+  const float* const x = x_.data();
+  const float* const y = y_.data();
+  const float* const previous_x = previous_x_.data();
+  const float* const previous_y = previous_y_.data();
+
+  // previous + (current - previous) * alpha, `kSimdWidth` particles at a time.
+  const auto alpha_v = simd_splat(alpha);
+  size_t i = 0;
+
+  for (; i + kSimdWidth <= count; i += kSimdWidth) {
+    const auto from_x = simd_load(previous_x + i);
+    const auto from_y = simd_load(previous_y + i);
+    const auto to_x = simd_load(x + i);
+    const auto to_y = simd_load(y + i);
+
+    simd_store(out_x.data() + i, from_x + (to_x - from_x) * alpha_v);
+    simd_store(out_y.data() + i, from_y + (to_y - from_y) * alpha_v);
+  }
+
+  for (; i < count; ++i) {
+    out_x[i] = previous_x[i] + (x[i] - previous_x[i]) * alpha;
+    out_y[i] = previous_y[i] + (y[i] - previous_y[i]) * alpha;
+  }
+}
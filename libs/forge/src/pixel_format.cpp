@@ -0,0 +1,79 @@
+#include <forge/pixel_format.h>
+
+#include "support/simd.h"
+
+#include <SDL3/SDL.h>
+
+constexpr size_t kBytesPerPixel = 4; // RGBA
+
+SDL_PixelFormat native_rgba_format(SDL_Renderer* renderer) {
+  SDL_assert(renderer != nullptr);
+
+  const auto* formats = static_cast<const SDL_PixelFormat*>(
+      SDL_GetPointerProperty(
+          SDL_GetRendererProperties(renderer),
+          SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER,
+          nullptr));
+
+  if (formats == nullptr) {
+    return SDL_PIXELFORMAT_RGBA32;
+  }
+
+  bool supports_bgra = false;
+
+  for (; *formats != SDL_PIXELFORMAT_UNKNOWN; ++formats) {
+    if (*formats == SDL_PIXELFORMAT_RGBA32) {
+      return SDL_PIXELFORMAT_RGBA32;
+    }
+
+    if (*formats == SDL_PIXELFORMAT_BGRA32) {
+      supports_bgra = true;
+    }
+  }
+
+  return supports_bgra ? SDL_PIXELFORMAT_BGRA32 : SDL_PIXELFORMAT_RGBA32;
+}
+
+void swap_red_blue(std::span<unsigned char> pixels) {
+  const auto pixel_count = pixels.size() / kBytesPerPixel;
+  auto* data = pixels.data();
+  size_t i = 0;
+
+#if FORGE_SIMD_AVX || FORGE_SIMD_SSE2
+  // Treat each pixel as a little endian 32-bit value and move the low and
+  // third bytes past each other, keeping green and alpha in place.
+  const auto green_alpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+  const auto low_byte = _mm_set1_epi32(0x000000FF);
+
+  for (; i + 4 <= pixel_count; i += 4) {
+    auto* p = reinterpret_cast<__m128i*>(data + i * kBytesPerPixel);
+    const auto v = _mm_loadu_si128(p);
+
+    const auto swapped = _mm_or_si128(
+        _mm_and_si128(v, green_alpha),
+        _mm_or_si128(
+            _mm_and_si128(_mm_srli_epi32(v, 16), low_byte),
+            _mm_slli_epi32(_mm_and_si128(v, low_byte), 16)));
+
+    _mm_storeu_si128(p, swapped);
+  }
+#elif FORGE_SIMD_NEON
+  // Deinterleave sixteen pixels into channel planes and store them back with
+  // the red and blue planes exchanged.
+  for (; i + 16 <= pixel_count; i += 16) {
+    auto* p = data + i * kBytesPerPixel;
+    auto channels = vld4q_u8(p);
+    const auto red = channels.val[0];
+    channels.val[0] = channels.val[2];
+    channels.val[2] = red;
+    vst4q_u8(p, channels);
+  }
+#endif
+
+  for (; i < pixel_count; ++i) {
+    auto* p = data + i * kBytesPerPixel;
+    const auto red = p[0];
+    p[0] = p[2];
+    p[2] = red;
+  }
+}
@@ -0,0 +1,156 @@
+#include <forge/spatial_grid.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+/// Largest cell coordinate on either axis, chosen so every cell is exactly
+/// representable as a float and stepping past it cannot overflow.
+constexpr float kMaxCell = 16777216.0f; // 2^24
+
+SpatialGrid::SpatialGrid(float cell_size)
+    : cell_size_(cell_size),
+      inverse_cell_size_(1.0f / cell_size) {
+  SDL_assert(cell_size > 0.0f);
+}
+
+void SpatialGrid::clear() {
+  staged_.clear();
+  bucket_start_.clear();
+  bucket_size_.clear();
+  ids_.clear();
+  bucket_mask_ = 0;
+}
+
+void SpatialGrid::insert(uint32_t id, float x, float y, float radius) {
+  staged_.push_back({.id = id, .cells = cells_for(x, y, radius)});
+}
+
+void SpatialGrid::build() {
+  // Size the bucket table to the number of entities so that the average bucket
+  // holds about one entity. The table is a power of two so hashing is a mask.
+  const auto entity_count = static_cast<uint32_t>(staged_.size());
+  const auto bucket_count = std::bit_ceil(std::max<uint32_t>(entity_count, 16));
+  bucket_mask_ = bucket_count - 1;
+
+  // Expand every staged entity into the buckets it covers.
+  bucket_entries_.clear();
+
+  for (const auto& entity : staged_) {
+    for_each_unique_bucket(entity.cells, [&](uint32_t bucket) {
+      bucket_entries_.emplace_back(bucket, entity.id);
+      return true;
+    });
+  }
+
+  // Counting sort the entries by bucket into a single packed id array.
+  bucket_start_.assign(bucket_count + 1, 0);
+  bucket_size_.assign(bucket_count, 0);
+
+  for (const auto& [bucket, id] : bucket_entries_) {
+    bucket_size_[bucket]++;
+  }
+
+  for (uint32_t bucket = 0; bucket < bucket_count; ++bucket) {
+    bucket_start_[bucket + 1] = bucket_start_[bucket] + bucket_size_[bucket];
+  }
+
+  ids_.resize(bucket_entries_.size());
+  std::ranges::fill(bucket_size_, 0);
+
+  for (const auto& [bucket, id] : bucket_entries_) {
+    ids_[bucket_start_[bucket] + bucket_size_[bucket]++] = id;
+  }
+
+  staged_.clear();
+}
+
+bool SpatialGrid::remove(uint32_t id, float x, float y, float radius) {
+  if (bucket_start_.empty()) {
+    return false;
+  }
+
+  bool found = false;
+
+  for_each_unique_bucket(cells_for(x, y, radius), [&](uint32_t bucket) {
+    const auto start = bucket_start_[bucket];
+    auto& size = bucket_size_[bucket];
+
+    // Swap the entity with the bucket's last live entry and shrink the bucket.
+    for (auto i = start; i < start + size; ++i) {
+      if (ids_[i] == id) {
+        ids_[i] = ids_[start + size - 1];
+        size--;
+        found = true;
+        break;
+      }
+    }
+
+    return true;
+  });
+
+  return found;
+}
+
+bool SpatialGrid::replace_id(
+    uint32_t old_id,
+    uint32_t new_id,
+    float x,
+    float y,
+    float radius) {
+  if (bucket_start_.empty()) {
+    return false;
+  }
+
+  bool found = false;
+
+  for_each_unique_bucket(cells_for(x, y, radius), [&](uint32_t bucket) {
+    const auto start = bucket_start_[bucket];
+    const auto end = start + bucket_size_[bucket];
+
+    for (auto i = start; i < end; ++i) {
+      if (ids_[i] == old_id) {
+        ids_[i] = new_id;
+        found = true;
+        break;
+      }
+    }
+
+    return true;
+  });
+
+  return found;
+}
+
+SpatialGrid::CellRange
+    SpatialGrid::cells_for(float x, float y, float radius) const {
+  // Clamp before converting, since converting a float outside the range of
+  // `int32_t` (or NaN) is undefined. Positions past the limit share the edge
+  // cell, which is slower to query but still correct.
+  const auto to_cell = [this](float position) {
+    const auto cell = std::floor(position * inverse_cell_size_);
+
+    if (std::isnan(cell)) {
+      return int32_t{0};
+    }
+
+    return static_cast<int32_t>(std::clamp(cell, -kMaxCell, kMaxCell));
+  };
+
+  return CellRange{
+      .min_x = to_cell(x - radius),
+      .min_y = to_cell(y - radius),
+      .max_x = to_cell(x + radius),
+      .max_y = to_cell(y + radius),
+  };
+}
+
+uint32_t SpatialGrid::bucket_for(int32_t cell_x, int32_t cell_y) const {
+  // Multiply by large primes and mix so that neighbouring cells land in
+  // unrelated buckets.
+  const auto hash = (static_cast<uint32_t>(cell_x) * 73856093u) ^
+                    (static_cast<uint32_t>(cell_y) * 19349663u);
+  return hash & bucket_mask_;
+}
@@ -0,0 +1,122 @@
+#include <forge/sprite_batch.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <numeric>
+
+void SpriteBatch::draw(
+    SDL_Texture* texture,
+    const SDL_FRect& src_rect,
+    const SDL_FRect& dest_rect,
+    const SDL_FColor color) {
+  SDL_assert(texture != nullptr);
+  auto& batch = batch_for(texture);
+
+  // Convert the source rectangle from texture pixels to normalized [0, 1]
+  // texture coordinates.
+  const float u0 = src_rect.x * batch.inverse_width;
+  const float v0 = src_rect.y * batch.inverse_height;
+  const float u1 = (src_rect.x + src_rect.w) * batch.inverse_width;
+  const float v1 = (src_rect.y + src_rect.h) * batch.inverse_height;
+
+  const float x0 = dest_rect.x;
+  const float y0 = dest_rect.y;
+  const float x1 = dest_rect.x + dest_rect.w;
+  const float y1 = dest_rect.y + dest_rect.h;
+
+  // Each sprite is a quad made from two triangles sharing the top left and
+  // bottom right corners.
+  const int first_vertex = static_cast<int>(batch.vertices.size());
+
+  batch.vertices.push_back({{x0, y0}, color, {u0, v0}});
+  batch.vertices.push_back({{x1, y0}, color, {u1, v0}});
+  batch.vertices.push_back({{x1, y1}, color, {u1, v1}});
+  batch.vertices.push_back({{x0, y1}, color, {u0, v1}});
+
+  batch.indices.push_back(first_vertex + 0);
+  batch.indices.push_back(first_vertex + 1);
+  batch.indices.push_back(first_vertex + 2);
+  batch.indices.push_back(first_vertex + 0);
+  batch.indices.push_back(first_vertex + 2);
+  batch.indices.push_back(first_vertex + 3);
+}
+
+bool SpriteBatch::flush(SDL_Renderer* renderer) {
+  SDL_assert(renderer != nullptr);
+  bool success = true;
+
+  for (auto& batch : batches_) {
+    if (batch.vertices.empty()) {
+      continue;
+    }
+
+    if (!SDL_RenderGeometry(
+            renderer,
+            batch.texture,
+            batch.vertices.data(),
+            static_cast<int>(batch.vertices.size()),
+            batch.indices.data(),
+            static_cast<int>(batch.indices.size()))) {
+      SDL_LogError(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "SpriteBatch::flush SDL_RenderGeometry error: %s",
+          SDL_GetError());
+      success = false;
+    }
+  }
+
+  clear();
+  return success;
+}
+
+void SpriteBatch::clear() {
+  // Clearing keeps the capacity of each buffer, which lets the next frame queue
+  // the same number of sprites without touching the heap.
+  for (auto& batch : batches_) {
+    batch.vertices.clear();
+    batch.indices.clear();
+  }
+}
+
+size_t SpriteBatch::sprite_count() const {
+  return std::accumulate(
+      batches_.begin(),
+      batches_.end(),
+      size_t{0},
+      [](size_t count, const TextureBatch& batch) {
+        return count + batch.vertices.size() / 4;
+      });
+}
+
+SpriteBatch::TextureBatch& SpriteBatch::batch_for(SDL_Texture* texture) {
+  // Games typically draw with a handful of textures so a linear search is
+  // faster than hashing.
+  auto itr = std::ranges::find_if(batches_, [texture](const auto& batch) {
+    return batch.texture == texture;
+  });
+
+  if (itr == batches_.end()) {
+    itr = batches_.insert(batches_.end(), TextureBatch{.texture = texture});
+  }
+
+  // Refresh the texture size the first time a texture is used after a flush in
+  // case the texture was destroyed and a new one allocated at the same address.
+  if (itr->vertices.empty()) {
+    float width = 0.0f, height = 0.0f;
+
+    if (!SDL_GetTextureSize(texture, &width, &height) || width <= 0.0f ||
+        height <= 0.0f) {
+      SDL_LogError(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "SpriteBatch failed to query texture size: %s",
+          SDL_GetError());
+      width = height = 1.0f;
+    }
+
+    itr->inverse_width = 1.0f / width;
+    itr->inverse_height = 1.0f / height;
+  }
+
+  return *itr;
+}
@@ -0,0 +1,174 @@
+#include <forge/support/mapped_file.h>
+
+#include <SDL3/SDL.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::unique_ptr<MappedFile> MappedFile::open(const std::string& path) {
+  std::unique_ptr<MappedFile> file{new MappedFile};
+
+  // Fall back to reading the file with SDL when it cannot be mapped, which
+  // also handles files that do not live in the native file system.
+  if (!file->map(path) && !file->read(path)) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "failed to open file %s: %s",
+        path.c_str(),
+        SDL_GetError());
+
+    return nullptr;
+  }
+
+  return file;
+}
+
+bool MappedFile::read(const std::string& path) {
+  size_t size = 0;
+  auto data = SDL_LoadFile(path.c_str(), &size);
+
+  if (data == nullptr) {
+    return false;
+  }
+
+  data_ = static_cast<const unsigned char*>(data);
+  size_ = size;
+  is_mapped_ = false;
+
+  return true;
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::map(const std::string& path) {
+  // Convert the UTF-8 path to UTF-16 for the wide Windows file APIs.
+  const auto wide_length =
+      MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+
+  if (wide_length <= 0) {
+    return false;
+  }
+
+  std::wstring wide_path(static_cast<size_t>(wide_length), L'\0');
+  MultiByteToWideChar(
+      CP_UTF8,
+      0,
+      path.c_str(),
+      -1,
+      wide_path.data(),
+      wide_length);
+
+  HANDLE file = CreateFileW(
+      wide_path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+      nullptr);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER file_size = {};
+
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+
+  // The mapping keeps its own reference to the file, so the file handle can
+  // be closed as soon as the mapping exists.
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+
+  if (mapping == nullptr) {
+    return false;
+  }
+
+  auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+  if (view == nullptr) {
+    CloseHandle(mapping);
+    return false;
+  }
+
+  data_ = static_cast<const unsigned char*>(view);
+  size_ = static_cast<size_t>(file_size.QuadPart);
+  mapping_handle_ = mapping;
+  is_mapped_ = true;
+
+  return true;
+}
+
+MappedFile::~MappedFile() {
+  if (is_mapped_) {
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(mapping_handle_));
+  } else {
+    SDL_free(const_cast<unsigned char*>(data_));
+  }
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+bool MappedFile::map(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat file_stat = {};
+
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  const auto size = static_cast<size_t>(file_stat.st_size);
+  auto view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+
+  if (view == MAP_FAILED) {
+    return false;
+  }
+
+  data_ = static_cast<const unsigned char*>(view);
+  size_ = size;
+  is_mapped_ = true;
+
+  return true;
+}
+
+MappedFile::~MappedFile() {
+  if (is_mapped_) {
+    munmap(const_cast<unsigned char*>(data_), size_);
+  } else {
+    SDL_free(const_cast<unsigned char*>(data_));
+  }
+}
+
+#else
+
+bool MappedFile::map(const std::string&) {
+  // Memory mapping is not supported on this platform.
+  return false;
+}
+
+MappedFile::~MappedFile() {
+  SDL_free(const_cast<unsigned char*>(data_));
+}
+
+#endif
@@ -0,0 +1,224 @@
+#pragma once
+
+// Thin wrapper over the platform's float SIMD registers so that hot loops can
+// be written once and compiled for SSE2, AVX or NEON. The widest instruction
+// set enabled by the compiler flags is selected at compile time, and a scalar
+// fallback is used everywhere else.
+//
+// This header is private to forge and is not installed with the public
+// headers.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__AVX__)
+#define FORGE_SIMD_AVX 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) ||                                 \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FORGE_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define FORGE_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define FORGE_SIMD_SCALAR 1
+#endif
+
+/// A register of `kSimdWidth` single precision floats.
+struct simd_f32 {
+#if FORGE_SIMD_AVX
+  __m256 v;
+#elif FORGE_SIMD_SSE2
+  __m128 v;
+#elif FORGE_SIMD_NEON
+  float32x4_t v;
+#else
+  float v;
+#endif
+};
+
+/// Number of float lanes in a `simd_f32`.
+#if FORGE_SIMD_AVX
+constexpr size_t kSimdWidth = 8;
+#elif FORGE_SIMD_SSE2 || FORGE_SIMD_NEON
+constexpr size_t kSimdWidth = 4;
+#else
+constexpr size_t kSimdWidth = 1;
+#endif
+
+/// Loads `kSimdWidth` floats from an unaligned address.
+inline simd_f32 simd_load(const float* p) {
+#if FORGE_SIMD_AVX
+  return {_mm256_loadu_ps(p)};
+#elif FORGE_SIMD_SSE2
+  return {_mm_loadu_ps(p)};
+#elif FORGE_SIMD_NEON
+  return {vld1q_f32(p)};
+#else
+  return {*p};
+#endif
+}
+
+/// Stores `kSimdWidth` floats to an unaligned address.
+inline void simd_store(float* p, simd_f32 a) {
+#if FORGE_SIMD_AVX
+  _mm256_storeu_ps(p, a.v);
+#elif FORGE_SIMD_SSE2
+  _mm_storeu_ps(p, a.v);
+#elif FORGE_SIMD_NEON
+  vst1q_f32(p, a.v);
+#else
+  *p = a.v;
+#endif
+}
+
+/// Returns a register with every lane set to `x`.
+inline simd_f32 simd_splat(float x) {
+#if FORGE_SIMD_AVX
+  return {_mm256_set1_ps(x)};
+#elif FORGE_SIMD_SSE2
+  return {_mm_set1_ps(x)};
+#elif FORGE_SIMD_NEON
+  return {vdupq_n_f32(x)};
+#else
+  return {x};
+#endif
+}
+
+inline simd_f32 operator+(simd_f32 a, simd_f32 b) {
+#if FORGE_SIMD_AVX
+  return {_mm256_add_ps(a.v, b.v)};
+#elif FORGE_SIMD_SSE2
+  return {_mm_add_ps(a.v, b.v)};
+#elif FORGE_SIMD_NEON
+  return {vaddq_f32(a.v, b.v)};
+#else
+  return {a.v + b.v};
+#endif
+}
+
+inline simd_f32 operator-(simd_f32 a, simd_f32 b) {
+#if FORGE_SIMD_AVX
+  return {_mm256_sub_ps(a.v, b.v)};
+#elif FORGE_SIMD_SSE2
+  return {_mm_sub_ps(a.v, b.v)};
+#elif FORGE_SIMD_NEON
+  return {vsubq_f32(a.v, b.v)};
+#else
+  return {a.v - b.v};
+#endif
+}
+
+inline simd_f32 operator*(simd_f32 a, simd_f32 b) {
+#if FORGE_SIMD_AVX
+  return {_mm256_mul_ps(a.v, b.v)};
+#elif FORGE_SIMD_SSE2
+  return {_mm_mul_ps(a.v, b.v)};
+#elif FORGE_SIMD_NEON
+  return {vmulq_f32(a.v, b.v)};
+#else
+  return {a.v * b.v};
+#endif
+}
+
+inline simd_f32 simd_min(simd_f32 a, simd_f32 b) {
+#if FORGE_SIMD_AVX
+  return {_mm256_min_ps(a.v, b.v)};
+#elif FORGE_SIMD_SSE2
+  return {_mm_min_ps(a.v, b.v)};
+#elif FORGE_SIMD_NEON
+  return {vminq_f32(a.v, b.v)};
+#else
+  return {a.v < b.v ? a.v : b.v};
+#endif
+}
+
+inline simd_f32 simd_max(simd_f32 a, simd_f32 b) {
+#if FORGE_SIMD_AVX
+  return {_mm256_max_ps(a.v, b.v)};
+#elif FORGE_SIMD_SSE2
+  return {_mm_max_ps(a.v, b.v)};
+#elif FORGE_SIMD_NEON
+  return {vmaxq_f32(a.v, b.v)};
+#else
+  return {a.v > b.v ? a.v : b.v};
+#endif
+}
+
+inline simd_f32 operator+(simd_f32 a, float b) { return a + simd_splat(b); }
+inline simd_f32 operator-(simd_f32 a, float b) { return a - simd_splat(b); }
+inline simd_f32 operator*(simd_f32 a, float b) { return a * simd_splat(b); }
+
+/// Negates `value` if the lowest mantissa bit of `bits` is set. Used with the
+/// round-to-integer trick that adds `1.5 * 2^23` to a float, which leaves the
+/// integer's parity in the lowest bit.
+inline float simd_negate_if_odd(float value, float bits) {
+  uint32_t value_bits = 0, parity_bits = 0;
+  std::memcpy(&value_bits, &value, sizeof(value));
+  std::memcpy(&parity_bits, &bits, sizeof(bits));
+
+  value_bits ^= parity_bits << 31;
+  std::memcpy(&value, &value_bits, sizeof(value));
+  return value;
+}
+
+/// SIMD version of `simd_negate_if_odd`, applied per lane.
+inline simd_f32 simd_negate_if_odd(simd_f32 value, simd_f32 bits) {
+#if FORGE_SIMD_AVX
+  // AVX1 has no 256-bit integer shifts so shift each 128-bit half instead.
+  const __m256i bits_i = _mm256_castps_si256(bits.v);
+  const __m128i lo = _mm_slli_epi32(_mm256_castsi256_si128(bits_i), 31);
+  const __m128i hi = _mm_slli_epi32(_mm256_extractf128_si256(bits_i, 1), 31);
+  const __m256i sign =
+      _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+  return {_mm256_xor_ps(value.v, _mm256_castsi256_ps(sign))};
+#elif FORGE_SIMD_SSE2
+  const __m128i sign = _mm_slli_epi32(_mm_castps_si128(bits.v), 31);
+  return {_mm_xor_ps(value.v, _mm_castsi128_ps(sign))};
+#elif FORGE_SIMD_NEON
+  const uint32x4_t sign = vshlq_n_u32(vreinterpretq_u32_f32(bits.v), 31);
+  return {vreinterpretq_f32_u32(
+      veorq_u32(vreinterpretq_u32_f32(value.v), sign))};
+#else
+  return {simd_negate_if_odd(value.v, bits.v)};
+#endif
+}
+
+/// Returns a bit mask where bit `i` is set if lane `i` of `a` is greater than
+/// or equal to lane `i` of `b`.
+inline uint32_t simd_ge_mask(simd_f32 a, simd_f32 b) {
+#if FORGE_SIMD_AVX
+  return static_cast<uint32_t>(
+      _mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)));
+#elif FORGE_SIMD_SSE2
+  return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(a.v, b.v)));
+#elif FORGE_SIMD_NEON
+  const uint32x4_t lane_bits = {1, 2, 4, 8};
+  const uint32x4_t bits = vandq_u32(vcgeq_f32(a.v, b.v), lane_bits);
+#if defined(__aarch64__) || defined(_M_ARM64)
+  return vaddvq_u32(bits);
+#else
+  const uint32x2_t pair = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+  return vget_lane_u32(vpadd_u32(pair, pair), 0);
+#endif
+#else
+  return a.v >= b.v ? 1u : 0u;
+#endif
+}
+
+/// Returns the index of the lowest set bit in a non-zero lane mask.
+inline uint32_t simd_lowest_lane(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index = 0;
+  _BitScanForward(&index, mask);
+  return static_cast<uint32_t>(index);
+#else
+  return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// Polynomial sine and cosine that are written once and instantiated for both
+// `float` and `simd_f32`. This header is private to forge, see
+// `forge/fast_math.h` for the public interface.
+
+#include "support/simd.h"
+
+// Adding this constant to a float with magnitude below 2^22 rounds it to the
+// nearest integer, and subtracting it again gives the rounded value back.
+constexpr float kSimdRoundMagic = 12582912.0f; // 1.5 * 2^23
+
+constexpr float kSimdInvPi = 0.318309886183790671538f;
+
+// Pi split into three parts for Cody-Waite range reduction. `kSimdPiA` has
+// only eight significant bits so `k * kSimdPiA` is exact for |k| < 2^16.
+constexpr float kSimdPiA = 3.140625f;
+constexpr float kSimdPiB = 9.67502593994140625e-4f;
+constexpr float kSimdPiC = 1.509957990978376432e-7f;
+
+// Coefficients of an odd degree 9 polynomial fit for minimum max error of
+// sin(r) over [-pi/2, pi/2]. The polynomial error (3.4e-9) is well below float
+// precision.
+constexpr float kSimdSinC1 = 0.9999999765957216f;
+constexpr float kSimdSinC3 = -0.16666647637448476f;
+constexpr float kSimdSinC5 = 8.3328998612338303e-3f;
+constexpr float kSimdSinC7 = -1.9800899696503836e-4f;
+constexpr float kSimdSinC9 = 2.5904918360603939e-6f;
+
+/// Evaluates sin(r) for r in [-pi/2, pi/2].
+template<typename V> inline V simd_sin_poly(V r) {
+  const V r2 = r * r;
+
+  V p = r2 * kSimdSinC9 + kSimdSinC7;
+  p = p * r2 + kSimdSinC5;
+  p = p * r2 + kSimdSinC3;
+  p = p * r2 + kSimdSinC1;
+
+  return r * p;
+}
+
+/// Approximates sin(x). See `fast_sin` in `forge/fast_math.h` for the
+/// accuracy bounds.
+template<typename V> inline V simd_sin(V x) {
+  // Find the nearest multiple of pi, and then reduce x into [-pi/2, pi/2]
+  // where sin(x) = (-1)^k * sin(x - k * pi).
+  const V biased_k = x * kSimdInvPi + kSimdRoundMagic;
+  const V k = biased_k - kSimdRoundMagic;
+  const V r = ((x - k * kSimdPiA) - k * kSimdPiB) - k * kSimdPiC;
+
+  return simd_negate_if_odd(simd_sin_poly(r), biased_k);
+}
+
+/// Approximates cos(x). See `fast_cos` in `forge/fast_math.h` for the
+/// accuracy bounds.
+template<typename V> inline V simd_cos(V x) {
+  // Find the nearest odd multiple of pi/2, written as (k + 0.5) * pi, and then
+  // reduce x into [-pi/2, pi/2] where cos(x) = (-1)^(k + 1) * sin(r).
+  const V biased_k = (x * kSimdInvPi - 0.5f) + kSimdRoundMagic;
+  const V h = (biased_k - kSimdRoundMagic) + 0.5f;
+  const V r = ((x - h * kSimdPiA) - h * kSimdPiB) - h * kSimdPiC;
+
+  return simd_negate_if_odd(simd_sin_poly(r) * -1.0f, biased_k);
+}
@@ -3,6 +3,9 @@
 #include <SDL3/SDL.h>
 #include <stb/stb_image.h>
 
+#include <algorithm>
+#include <cstring>
+
 stbi_io_callbacks create_stbi_sdl2_io_callbacks() {
   return stbi_io_callbacks{
       .read = [](void* user, char* data, int size) -> int {
@@ -23,6 +26,84 @@ stbi_io_callbacks create_stbi_sdl2_io_callbacks() {
       }};
 }
 
+BufferedSdlReader::BufferedSdlReader(SDL_IOStream* stream, size_t block_size)
+    : stream_(stream),
+      buffer_(std::max<size_t>(block_size, 1)) {
+  SDL_assert(stream != nullptr);
+}
+
+size_t BufferedSdlReader::read(void* data, size_t size) {
+  auto* out = static_cast<unsigned char*>(data);
+  size_t copied = 0;
+
+  while (copied < size) {
+    if (position_ == end_) {
+      // Read requests at least as large as a block straight into the caller's
+      // memory, since buffering them would only add a copy.
+      if (size - copied >= buffer_.size()) {
+        copied += SDL_ReadIO(stream_, out + copied, size - copied);
+        break;
+      }
+
+      if (!refill()) {
+        break;
+      }
+    }
+
+    const auto count = std::min(size - copied, end_ - position_);
+    std::memcpy(out + copied, buffer_.data() + position_, count);
+
+    position_ += count;
+    copied += count;
+  }
+
+  return copied;
+}
+
+void BufferedSdlReader::skip(int64_t count) {
+  const auto buffered = static_cast<int64_t>(end_ - position_);
+
+  if (count >= -static_cast<int64_t>(position_) && count <= buffered) {
+    position_ = static_cast<size_t>(static_cast<int64_t>(position_) + count);
+    return;
+  }
+
+  // The stream is positioned at the end of the buffered block, so seek from
+  // there and drop the block.
+  SDL_SeekIO(stream_, count - buffered, SDL_IO_SEEK_CUR);
+  position_ = 0;
+  end_ = 0;
+}
+
+bool BufferedSdlReader::eof() const {
+  return position_ == end_ && SDL_GetIOStatus(stream_) == SDL_IO_STATUS_EOF;
+}
+
+bool BufferedSdlReader::refill() {
+  position_ = 0;
+  end_ = SDL_ReadIO(stream_, buffer_.data(), buffer_.size());
+
+  return end_ > 0;
+}
+
+stbi_io_callbacks create_stbi_buffered_io_callbacks() {
+  return stbi_io_callbacks{
+      .read = [](void* user, char* data, int size) -> int {
+        SDL_assert(user != nullptr);
+        auto reader = static_cast<BufferedSdlReader*>(user);
+        return static_cast<int>(
+            reader->read(data, static_cast<size_t>(std::max(size, 0))));
+      },
+      .skip = [](void* user, int n) -> void {
+        SDL_assert(user != nullptr);
+        static_cast<BufferedSdlReader*>(user)->skip(n);
+      },
+      .eof = [](void* user) -> int {
+        SDL_assert(user != nullptr);
+        return static_cast<BufferedSdlReader*>(user)->eof() ? 1 : 0;
+      }};
+}
+
 void StbImageBytesDeleter::operator()(
     unsigned char* image_bytes) const noexcept {
   stbi_image_free(image_bytes);
@@ -0,0 +1,300 @@
+#include <forge/texture_atlas.h>
+
+#include <forge/pixel_format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+constexpr int kBytesPerPixel = 4; // RGBA
+
+SkylinePacker::SkylinePacker(int width, int height)
+    : width_(width),
+      height_(height) {
+  SDL_assert(width > 0 && height > 0);
+  clear();
+}
+
+std::optional<SDL_Rect> SkylinePacker::pack(int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return std::nullopt;
+  }
+
+  // Find the position that leaves the rectangle's top edge lowest, breaking
+  // ties with the narrowest segment to keep wide gaps free for wide images.
+  std::optional<size_t> best_index;
+  int best_y = 0;
+  int best_top = std::numeric_limits<int>::max();
+  int best_segment_width = std::numeric_limits<int>::max();
+
+  for (size_t i = 0; i < skyline_.size(); ++i) {
+    const auto y = fit(i, width, height);
+
+    if (!y) {
+      continue;
+    }
+
+    const auto top = *y + height;
+
+    if (top < best_top ||
+        (top == best_top && skyline_[i].width < best_segment_width)) {
+      best_index = i;
+      best_y = *y;
+      best_top = top;
+      best_segment_width = skyline_[i].width;
+    }
+  }
+
+  if (!best_index) {
+    return std::nullopt;
+  }
+
+  const auto x = skyline_[*best_index].x;
+
+  // Raise the skyline over the new rectangle, and trim or remove the segments
+  // it now covers.
+  skyline_.insert(
+      skyline_.begin() + static_cast<ptrdiff_t>(*best_index),
+      Segment{.x = x, .y = best_top, .width = width});
+
+  for (auto i = *best_index + 1; i < skyline_.size();) {
+    const auto covered_end = skyline_[i - 1].x + skyline_[i - 1].width;
+    auto& segment = skyline_[i];
+
+    if (segment.x >= covered_end) {
+      break;
+    }
+
+    const auto overlap = covered_end - segment.x;
+
+    if (overlap < segment.width) {
+      segment.x += overlap;
+      segment.width -= overlap;
+      break;
+    }
+
+    skyline_.erase(skyline_.begin() + static_cast<ptrdiff_t>(i));
+  }
+
+  // Merge neighbouring segments at the same height.
+  for (size_t i = 0; i + 1 < skyline_.size();) {
+    if (skyline_[i].y == skyline_[i + 1].y) {
+      skyline_[i].width += skyline_[i + 1].width;
+      skyline_.erase(skyline_.begin() + static_cast<ptrdiff_t>(i + 1));
+    } else {
+      ++i;
+    }
+  }
+
+  used_area_ += static_cast<int64_t>(width) * height;
+  return SDL_Rect{x, best_y, width, height};
+}
+
+void SkylinePacker::clear() {
+  skyline_.clear();
+  skyline_.push_back(Segment{.x = 0, .y = 0, .width = width_});
+  used_area_ = 0;
+}
+
+float SkylinePacker::occupancy() const {
+  return static_cast<float>(used_area_) /
+         (static_cast<float>(width_) * static_cast<float>(height_));
+}
+
+std::optional<int>
+    SkylinePacker::fit(size_t index, int width, int height) const {
+  const auto x = skyline_[index].x;
+
+  if (x + width > width_) {
+    return std::nullopt;
+  }
+
+  // The rectangle rests on the highest segment under it.
+  int y = 0;
+  int width_left = width;
+
+  for (auto i = index; width_left > 0; ++i) {
+    SDL_assert(i < skyline_.size());
+    y = std::max(y, skyline_[i].y);
+
+    if (y + height > height_) {
+      return std::nullopt;
+    }
+
+    width_left -= skyline_[i].width;
+  }
+
+  return y;
+}
+
+TextureAtlas::TextureAtlas(int page_size) : page_size_(page_size) {
+  SDL_assert(page_size > 2 * kPadding);
+}
+
+std::optional<AtlasRegion> TextureAtlas::add(
+    const DecodedImage& image,
+    std::string_view name) {
+  if (image.pixels == nullptr || image.width <= 0 || image.height <= 0) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "cannot add empty image %.*s to texture atlas",
+        static_cast<int>(name.length()),
+        name.data());
+    return std::nullopt;
+  }
+
+  if (!name.empty()) {
+    if (auto existing = find(name); existing) {
+      return existing;
+    }
+  }
+
+  const auto padded_width = image.width + 2 * kPadding;
+  const auto padded_height = image.height + 2 * kPadding;
+
+  if (padded_width > page_size_ || padded_height > page_size_) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "image %.*s (%dx%d) is too large for a %d pixel texture atlas page",
+        static_cast<int>(name.length()),
+        name.data(),
+        image.width,
+        image.height,
+        page_size_);
+    return std::nullopt;
+  }
+
+  // Place the image on the first page with room, or start a new page.
+  std::optional<SDL_Rect> rect;
+  size_t page = 0;
+
+  for (; page < pages_.size() && !rect; ++page) {
+    rect = pages_[page].packer.pack(padded_width, padded_height);
+  }
+
+  if (rect) {
+    page--;
+  } else {
+    pages_.push_back(Page{
+        .packer = SkylinePacker(page_size_, page_size_),
+        .texture = nullptr,
+    });
+
+    page = pages_.size() - 1;
+    rect = pages_[page].packer.pack(padded_width, padded_height);
+    SDL_assert(rect.has_value());
+  }
+
+  // Copy the image with its edge pixels repeated into the padding.
+  std::vector<unsigned char> pixels(
+      static_cast<size_t>(padded_width) * padded_height * kBytesPerPixel);
+  const auto* source = image.pixels.get();
+  const auto source_pitch = static_cast<size_t>(image.width) * kBytesPerPixel;
+  const auto dest_pitch = static_cast<size_t>(padded_width) * kBytesPerPixel;
+
+  for (int y = 0; y < padded_height; ++y) {
+    const auto source_y = std::clamp(y - kPadding, 0, image.height - 1);
+    const auto* source_row = source + source_y * source_pitch;
+    auto* dest_row = pixels.data() + y * dest_pitch;
+
+    std::memcpy(dest_row + kPadding * kBytesPerPixel, source_row, source_pitch);
+
+    for (int x = 0; x < kPadding; ++x) {
+      std::memcpy(dest_row + x * kBytesPerPixel, source_row, kBytesPerPixel);
+      std::memcpy(
+          dest_row + (kPadding + image.width + x) * kBytesPerPixel,
+          source_row + source_pitch - kBytesPerPixel,
+          kBytesPerPixel);
+    }
+  }
+
+  pending_uploads_.push_back(PendingUpload{
+      .page = page,
+      .rect = *rect,
+      .pixels = std::move(pixels),
+  });
+
+  const AtlasRegion region{
+      .page = page,
+      .src_rect = SDL_FRect{
+          static_cast<float>(rect->x + kPadding),
+          static_cast<float>(rect->y + kPadding),
+          static_cast<float>(image.width),
+          static_cast<float>(image.height)},
+  };
+
+  if (!name.empty()) {
+    named_regions_.emplace(std::string{name}, region);
+  }
+
+  return region;
+}
+
+std::optional<AtlasRegion> TextureAtlas::find(std::string_view name) const {
+  if (const auto itr = named_regions_.find(std::string{name});
+      itr != named_regions_.end()) {
+    return itr->second;
+  }
+
+  return std::nullopt;
+}
+
+bool TextureAtlas::upload(SDL_Renderer* renderer) {
+  SDL_assert(renderer != nullptr);
+
+  if (pending_uploads_.empty()) {
+    return true;
+  }
+
+  // Create textures for pages added since the last upload, in a layout the
+  // renderer supports so images are copied without conversion.
+  if (page_format_ == SDL_PIXELFORMAT_UNKNOWN) {
+    page_format_ = native_rgba_format(renderer);
+  }
+
+  for (auto& page : pages_) {
+    if (page.texture != nullptr) {
+      continue;
+    }
+
+    page.texture.reset(SDL_CreateTexture(
+        renderer,
+        page_format_,
+        SDL_TEXTUREACCESS_STATIC,
+        page_size_,
+        page_size_));
+
+    if (page.texture == nullptr) {
+      SDL_LogError(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "failed to create texture atlas page: %s",
+          SDL_GetError());
+      return false;
+    }
+
+    SDL_SetTextureBlendMode(page.texture.get(), SDL_BLENDMODE_BLEND);
+  }
+
+  bool success = true;
+
+  for (auto& upload : pending_uploads_) {
+    if (page_format_ == SDL_PIXELFORMAT_BGRA32) {
+      swap_red_blue(upload.pixels);
+    }
+
+    if (!SDL_UpdateTexture(
+            pages_[upload.page].texture.get(),
+            &upload.rect,
+            upload.pixels.data(),
+            upload.rect.w * kBytesPerPixel)) {
+      SDL_LogError(
+          SDL_LOG_CATEGORY_APPLICATION,
+          "failed to update texture atlas page: %s",
+          SDL_GetError());
+      success = false;
+    }
+  }
+
+  pending_uploads_.clear();
+  return success;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <forge/support/sdl_support.h>
+
+#include <SDL3/SDL.h>
+
+#include <cstdint>
+#include <memory>
+
+/// Wraps a stream and counts the reads that reach it, each of which is at least
+/// one system call for a file stream. Read from `stream`, and the reads are
+/// passed on to `source`, which must outlive the wrapper.
+struct CountingStream {
+  explicit CountingStream(SDL_IOStream* source) : source(source) {
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+
+    iface.size = [](void* user) {
+      return SDL_GetIOSize(static_cast<CountingStream*>(user)->source);
+    };
+    iface.seek = [](void* user, Sint64 offset, SDL_IOWhence whence) {
+      return SDL_SeekIO(
+          static_cast<CountingStream*>(user)->source,
+          offset,
+          whence);
+    };
+    iface.read =
+        [](void* user, void* data, size_t size, SDL_IOStatus* status) {
+          auto* self = static_cast<CountingStream*>(user);
+          self->read_count++;
+
+          const auto count = SDL_ReadIO(self->source, data, size);
+          *status = SDL_GetIOStatus(self->source);
+          return count;
+        };
+
+    stream.reset(SDL_OpenIO(&iface, this));
+  }
+
+  // The stream's callbacks point at this object.
+  CountingStream(const CountingStream&) = delete;
+  CountingStream& operator=(const CountingStream&) = delete;
+
+  SDL_IOStream* source = nullptr;
+  std::unique_ptr<SDL_IOStream, SdlIoCloser> stream;
+  int64_t read_count = 0;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+/// Owns a software renderer drawing into an offscreen surface, so textures can
+/// be created without a window or GPU.
+struct SoftwareRenderer {
+  SoftwareRenderer()
+      : surface(SDL_CreateSurface(512, 512, SDL_PIXELFORMAT_RGBA32)),
+        renderer(
+            surface != nullptr ? SDL_CreateSoftwareRenderer(surface)
+                               : nullptr) {}
+
+  ~SoftwareRenderer() {
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+  }
+
+  SoftwareRenderer(const SoftwareRenderer&) = delete;
+  SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+  SDL_Surface* surface = nullptr;
+  SDL_Renderer* renderer = nullptr;
+};
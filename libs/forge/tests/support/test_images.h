@@ -0,0 +1,31 @@
+#pragma once
+
+#include <forge/content.h>
+
+#include <cstdlib>
+#include <random>
+
+/// Creates an image filled with random pixels. The pixels are allocated with
+/// `malloc` the same way stb_image allocates decoded pixels, so the image can
+/// be freed by `DecodedImage`.
+///
+/// @param seed Seed for the pixel values, so that each test sees the same
+///             image every run.
+inline DecodedImage
+    make_test_image(int width, int height, unsigned int seed = 0) {
+  DecodedImage image;
+  image.width = width;
+  image.height = height;
+
+  const auto size = static_cast<size_t>(width) * height * 4;
+  image.pixels.reset(static_cast<unsigned char*>(std::malloc(size)));
+
+  std::default_random_engine engine(seed);
+  std::uniform_int_distribution<int> value(0, 255);
+
+  for (size_t i = 0; i < size; ++i) {
+    image.pixels.get()[i] = static_cast<unsigned char>(value(engine));
+  }
+
+  return image;
+}
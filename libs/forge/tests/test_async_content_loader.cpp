@@ -0,0 +1,177 @@
+#include <forge/async_content_loader.h>
+#include <forge/content_cache.h>
+
+#include <gtest/gtest.h>
+
+#include "support/software_renderer.h"
+
+#include <chrono>
+#include <future>
+#include <vector>
+
+// These tests read the game's own content files, which the build copies next
+// to the test executable.
+constexpr const char* kImageFilename = "content/bubble.png";
+constexpr const char* kMissingFilename = "content/missing.png";
+constexpr const char* kOggFilename = "content/pop.ogg";
+
+namespace {
+  constexpr auto kTimeout = std::chrono::seconds(10);
+
+  template <typename T> bool is_ready(const std::future<T>& future) {
+    return future.wait_for(std::chrono::seconds(0)) ==
+           std::future_status::ready;
+  }
+
+  template <typename T> bool wait_ready(const std::future<T>& future) {
+    return future.wait_for(kTimeout) == std::future_status::ready;
+  }
+} // namespace
+
+TEST(AsyncContentLoaderTest, MissingFilesResolveToNull) {
+  AsyncContentLoader loader(1);
+
+  auto image = loader.load_image(kMissingFilename);
+  auto mip_chain = loader.load_mip_chain(kMissingFilename, 1);
+  auto audio = loader.load_ogg("content/missing.ogg");
+  auto texture = loader.load_texture(kMissingFilename);
+
+  // A texture that fails to decode never waits for `process_uploads`.
+  ASSERT_TRUE(wait_ready(texture));
+  ASSERT_TRUE(wait_ready(image));
+  ASSERT_TRUE(wait_ready(mip_chain));
+  ASSERT_TRUE(wait_ready(audio));
+
+  EXPECT_EQ(texture.get(), nullptr);
+  EXPECT_EQ(image.get().pixels, nullptr);
+  EXPECT_EQ(mip_chain.get().level_count(), 0u);
+  EXPECT_EQ(audio.get(), nullptr);
+  EXPECT_EQ(loader.pending_count(), 0u);
+}
+
+TEST(AsyncContentLoaderTest, PendingCountTracksRequests) {
+  SoftwareRenderer software;
+  ASSERT_NE(software.renderer, nullptr);
+
+  AsyncContentLoader loader(1);
+  EXPECT_EQ(loader.pending_count(), 0u);
+
+  auto texture = loader.load_texture(kImageFilename);
+  auto image = loader.load_image(kImageFilename);
+  EXPECT_GE(loader.pending_count(), 1u);
+  EXPECT_LE(loader.pending_count(), 2u);
+
+  // With one worker the texture is decoded before the image, but stays
+  // pending until its texture is created.
+  ASSERT_TRUE(wait_ready(image));
+  EXPECT_NE(image.get().pixels, nullptr);
+  EXPECT_FALSE(is_ready(texture));
+  EXPECT_EQ(loader.pending_count(), 1u);
+
+  EXPECT_EQ(loader.process_uploads(software.renderer), 1u);
+  EXPECT_EQ(loader.pending_count(), 0u);
+  ASSERT_TRUE(is_ready(texture));
+  EXPECT_NE(texture.get(), nullptr);
+}
+
+TEST(AsyncContentLoaderTest, TexturesAreCreatedByTheNextProcessUploads) {
+  SoftwareRenderer software;
+  ASSERT_NE(software.renderer, nullptr);
+
+  AsyncContentLoader loader(1);
+  EXPECT_EQ(loader.process_uploads(software.renderer), 0u);
+
+  auto first = loader.load_texture(kImageFilename);
+  auto second = loader.load_texture(kImageFilename);
+
+  // Requests run in order on the single worker, so once this image is ready
+  // both textures have been decoded.
+  auto fence = loader.load_image(kMissingFilename);
+  ASSERT_TRUE(wait_ready(fence));
+
+  EXPECT_FALSE(is_ready(first));
+  EXPECT_FALSE(is_ready(second));
+  EXPECT_EQ(loader.process_uploads(software.renderer), 2u);
+  ASSERT_TRUE(is_ready(first));
+  ASSERT_TRUE(is_ready(second));
+  EXPECT_NE(first.get(), nullptr);
+  EXPECT_NE(second.get(), nullptr);
+
+  // A texture decoded after that call waits for the next one.
+  auto third = loader.load_texture(kImageFilename);
+  fence = loader.load_image(kMissingFilename);
+  ASSERT_TRUE(wait_ready(fence));
+
+  EXPECT_FALSE(is_ready(third));
+  EXPECT_EQ(loader.process_uploads(software.renderer), 1u);
+  ASSERT_TRUE(is_ready(third));
+  EXPECT_NE(third.get(), nullptr);
+}
+
+TEST(AsyncContentLoaderTest, SharesContentThroughTheCache) {
+  SoftwareRenderer software;
+  ASSERT_NE(software.renderer, nullptr);
+
+  ContentCache cache(software.renderer);
+  AsyncContentLoader loader(1, &cache);
+
+  auto texture = loader.load_texture(kImageFilename);
+  auto audio = loader.load_ogg(kOggFilename);
+  auto fence = loader.load_image(kMissingFilename);
+  ASSERT_TRUE(wait_ready(fence));
+
+  // Loaded content is handed over and cached on this thread.
+  EXPECT_FALSE(is_ready(audio));
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(loader.process_uploads(software.renderer), 2u);
+  EXPECT_EQ(cache.size(), 2u);
+
+  ASSERT_TRUE(is_ready(texture));
+  ASSERT_TRUE(is_ready(audio));
+  const auto first_texture = texture.get();
+  const auto first_audio = audio.get();
+  ASSERT_NE(first_texture, nullptr);
+  ASSERT_NE(first_audio, nullptr);
+
+  // Cached content is ready without waiting for a worker.
+  texture = loader.load_texture(kImageFilename);
+  audio = loader.load_ogg(kOggFilename);
+  ASSERT_TRUE(is_ready(texture));
+  ASSERT_TRUE(is_ready(audio));
+  EXPECT_EQ(texture.get(), first_texture);
+  EXPECT_EQ(audio.get(), first_audio);
+  EXPECT_EQ(loader.pending_count(), 0u);
+}
+
+TEST(AsyncContentLoaderTest, DestroyingTheLoaderAbandonsQueuedRequests) {
+  constexpr size_t kRequestCount = 32;
+  std::vector<std::future<DecodedImage>> images;
+  std::vector<std::future<std::shared_ptr<SDL_Texture>>> textures;
+
+  {
+    AsyncContentLoader loader(1);
+
+    for (size_t i = 0; i < kRequestCount; ++i) {
+      images.push_back(loader.load_image(kImageFilename));
+      textures.push_back(loader.load_texture(kImageFilename));
+    }
+  }
+
+  // Every request either finished before the loader stopped, or was abandoned
+  // with a broken promise. Nothing is left waiting.
+  for (auto& image : images) {
+    ASSERT_TRUE(is_ready(image));
+
+    try {
+      EXPECT_NE(image.get().pixels, nullptr);
+    } catch (const std::future_error& error) {
+      EXPECT_EQ(error.code(), std::future_errc::broken_promise);
+    }
+  }
+
+  // Textures are never created without `process_uploads`.
+  for (auto& texture : textures) {
+    ASSERT_TRUE(is_ready(texture));
+    EXPECT_THROW(texture.get(), std::future_error);
+  }
+}
@@ -0,0 +1,214 @@
+#include <forge/audio_mixer.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+  /// Creates `frame_count` stereo frames with every sample set to `value`.
+  std::vector<float> constant_sound(size_t frame_count, float value) {
+    return std::vector<float>(frame_count * 2, value);
+  }
+} // namespace
+
+TEST(AudioMixerTest, MixesSilenceWithNoVoices) {
+  AudioMixer mixer;
+  std::vector<float> output(64, 123.0f);
+
+  mixer.mix(output);
+
+  for (auto sample : output) {
+    EXPECT_EQ(sample, 0.0f);
+  }
+}
+
+TEST(AudioMixerTest, OverlappingVoicesAreSummed) {
+  AudioMixer mixer;
+  const auto a = constant_sound(100, 0.25f);
+  const auto b = constant_sound(100, 0.125f);
+
+  mixer.play(a);
+  mixer.play(b);
+  EXPECT_EQ(mixer.active_voice_count(), 2);
+
+  std::vector<float> output(2 * 37);
+  mixer.mix(output);
+
+  for (auto sample : output) {
+    EXPECT_FLOAT_EQ(sample, 0.375f);
+  }
+}
+
+TEST(AudioMixerTest, GainAndPanScaleChannels) {
+  AudioMixer mixer;
+  const auto sound = constant_sound(100, 0.5f);
+
+  const auto voice = mixer.play(sound, {.gain = 0.5f, .pan = -0.5f});
+  std::vector<float> output(2 * 19);
+  mixer.mix(output);
+
+  for (size_t i = 0; i < output.size(); i += 2) {
+    EXPECT_FLOAT_EQ(output[i], 0.25f);
+    EXPECT_FLOAT_EQ(output[i + 1], 0.125f);
+  }
+
+  mixer.set_pan(voice, 1.0f);
+  mixer.set_gain(voice, 1.0f);
+  mixer.mix(output);
+
+  for (size_t i = 0; i < output.size(); i += 2) {
+    EXPECT_FLOAT_EQ(output[i], 0.0f);
+    EXPECT_FLOAT_EQ(output[i + 1], 0.5f);
+  }
+}
+
+TEST(AudioMixerTest, OutputIsClamped) {
+  AudioMixer mixer;
+  const auto loud = constant_sound(100, 0.75f);
+  const auto quiet = constant_sound(100, -0.75f);
+
+  mixer.play(loud);
+  mixer.play(loud);
+
+  std::vector<float> output(2 * 21);
+  mixer.mix(output);
+
+  for (auto sample : output) {
+    EXPECT_EQ(sample, 1.0f);
+  }
+
+  mixer.stop_all();
+  mixer.play(quiet);
+  mixer.play(quiet);
+  mixer.mix(output);
+
+  for (auto sample : output) {
+    EXPECT_EQ(sample, -1.0f);
+  }
+}
+
+TEST(AudioMixerTest, VoiceStopsAtEndOfSound) {
+  AudioMixer mixer;
+  const auto sound = constant_sound(10, 0.5f);
+
+  const auto voice = mixer.play(sound);
+  std::vector<float> output(2 * 16);
+  mixer.mix(output);
+
+  for (size_t i = 0; i < output.size(); ++i) {
+    EXPECT_FLOAT_EQ(output[i], i < 20 ? 0.5f : 0.0f) << i;
+  }
+
+  EXPECT_FALSE(mixer.is_playing(voice));
+  EXPECT_EQ(mixer.active_voice_count(), 0);
+}
+
+TEST(AudioMixerTest, LoopingVoiceWrapsAround) {
+  AudioMixer mixer;
+  const std::vector<float> sound = {0.1f, 0.1f, 0.2f, 0.2f, 0.3f, 0.3f};
+
+  const auto voice = mixer.play(sound, {.loop = true});
+  std::vector<float> output(2 * 8);
+  mixer.mix(output);
+
+  for (size_t frame = 0; frame < 8; ++frame) {
+    EXPECT_FLOAT_EQ(output[frame * 2], sound[(frame % 3) * 2]) << frame;
+  }
+
+  EXPECT_TRUE(mixer.is_playing(voice));
+}
+
+TEST(AudioMixerTest, StoppedVoiceIdIsNotReused) {
+  AudioMixer mixer;
+  const auto sound = constant_sound(10, 0.5f);
+
+  const auto first = mixer.play(sound);
+  mixer.stop(first);
+  const auto second = mixer.play(sound);
+
+  EXPECT_NE(first, kInvalidVoiceId);
+  EXPECT_NE(first, second);
+  EXPECT_FALSE(mixer.is_playing(first));
+  EXPECT_TRUE(mixer.is_playing(second));
+
+  // Changing a stale voice must not affect the new one.
+  mixer.stop(first);
+  EXPECT_TRUE(mixer.is_playing(second));
+}
+
+TEST(AudioMixerTest, OldestVoiceIsStolenWhenFull) {
+  AudioMixer mixer;
+  const auto sound = constant_sound(10, 0.0f);
+
+  std::vector<VoiceId> voices;
+
+  for (size_t i = 0; i < AudioMixer::kMaxVoices; ++i) {
+    voices.push_back(mixer.play(sound));
+  }
+
+  const auto newest = mixer.play(sound);
+
+  EXPECT_NE(newest, kInvalidVoiceId);
+  EXPECT_FALSE(mixer.is_playing(voices.front()));
+  EXPECT_TRUE(mixer.is_playing(voices.back()));
+  EXPECT_EQ(mixer.active_voice_count(), AudioMixer::kMaxVoices);
+}
+
+TEST(AudioMixerTest, LoopingVoicesAreNotStolen) {
+  AudioMixer mixer;
+  const auto sound = constant_sound(10, 0.0f);
+
+  for (size_t i = 0; i < AudioMixer::kMaxVoices; ++i) {
+    mixer.play(sound, {.loop = true});
+  }
+
+  EXPECT_EQ(mixer.play(sound), kInvalidVoiceId);
+}
+
+TEST(AudioMixerTest, FadeReachesTargetGain) {
+  AudioMixer mixer;
+  const auto sound = constant_sound(1000, 1.0f);
+
+  const auto voice = mixer.play(sound);
+  mixer.fade(voice, 0.0f, 200);
+
+  std::vector<float> output(2 * 100);
+  mixer.mix(output);
+
+  // The gain steps down during the fade.
+  EXPECT_FLOAT_EQ(output.front(), 1.0f);
+  EXPECT_LT(output.back(), 1.0f);
+  EXPECT_GT(output.back(), 0.0f);
+
+  mixer.mix(output);
+  mixer.mix(output);
+
+  EXPECT_TRUE(mixer.is_playing(voice));
+  EXPECT_FLOAT_EQ(output.front(), 0.0f);
+  EXPECT_FLOAT_EQ(output.back(), 0.0f);
+}
+
+TEST(AudioMixerTest, FadeCanStopVoice) {
+  AudioMixer mixer;
+  const auto sound = constant_sound(1000, 1.0f);
+
+  const auto voice = mixer.play(sound, {.loop = true});
+  mixer.fade(voice, 0.0f, 50, true);
+
+  std::vector<float> output(2 * 100);
+  mixer.mix(output);
+
+  EXPECT_FALSE(mixer.is_playing(voice));
+  EXPECT_FLOAT_EQ(output[2 * 60], 0.0f);
+}
+
+TEST(AudioMixerTest, PlayWithCreatedId) {
+  AudioMixer mixer;
+  const auto sound = constant_sound(10, 0.5f);
+
+  const auto id = mixer.create_voice_id();
+  EXPECT_FALSE(mixer.is_playing(id));
+
+  EXPECT_TRUE(mixer.play(id, sound));
+  EXPECT_TRUE(mixer.is_playing(id));
+}
@@ -0,0 +1,145 @@
+#include <forge/content_archive.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+  /// Writes a content archive the same way the `content_packer` tool does, and
+  /// returns the path to the archive.
+  std::string write_archive(
+      const std::string& name,
+      std::vector<std::pair<std::string, std::string>> files) {
+    std::ranges::sort(files);
+
+    std::string path_table;
+    std::vector<ContentArchiveEntry> entries(files.size());
+
+    for (size_t i = 0; i < files.size(); ++i) {
+      entries[i].path_offset = static_cast<uint32_t>(path_table.size());
+      entries[i].path_length = static_cast<uint32_t>(files[i].first.size());
+      path_table += files[i].first;
+    }
+
+    ContentArchiveHeader header;
+    std::memcpy(header.magic, kContentArchiveMagic, sizeof(header.magic));
+    header.version = kContentArchiveVersion;
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    header.path_table_size = static_cast<uint32_t>(path_table.size());
+
+    std::string bytes(
+        sizeof(header) + entries.size() * sizeof(ContentArchiveEntry) +
+            path_table.size(),
+        '\0');
+
+    for (size_t i = 0; i < files.size(); ++i) {
+      bytes.resize(
+          (bytes.size() + kContentArchiveAlignment - 1) &
+          ~(kContentArchiveAlignment - 1));
+      entries[i].offset = bytes.size();
+      entries[i].size = files[i].second.size();
+      bytes += files[i].second;
+    }
+
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(
+        bytes.data() + sizeof(header),
+        entries.data(),
+        entries.size() * sizeof(ContentArchiveEntry));
+    std::memcpy(
+        bytes.data() + sizeof(header) +
+            entries.size() * sizeof(ContentArchiveEntry),
+        path_table.data(),
+        path_table.size());
+
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream{path, std::ios::binary} << bytes;
+
+    return path.string();
+  }
+
+  std::string as_string(std::span<const unsigned char> bytes) {
+    return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+  }
+} // namespace
+
+TEST(ContentArchiveTest, FindsEveryPackedFile) {
+  const auto path = write_archive(
+      "forge_test_find.fpak",
+      {{"content/b.txt", "bravo"},
+       {"content/a.txt", "alpha"},
+       {"content/sub/c.txt", "charlie!"}});
+
+  auto archive = ContentArchive::open(path);
+  ASSERT_NE(archive, nullptr);
+  EXPECT_EQ(archive->size(), 3);
+
+  EXPECT_EQ(as_string(*archive->find("content/a.txt")), "alpha");
+  EXPECT_EQ(as_string(*archive->find("content/b.txt")), "bravo");
+  EXPECT_EQ(as_string(*archive->find("content/sub/c.txt")), "charlie!");
+}
+
+TEST(ContentArchiveTest, FilesAreAligned) {
+  const auto path = write_archive(
+      "forge_test_aligned.fpak",
+      {{"a", "1"}, {"b", "22"}, {"c", "333"}});
+
+  auto archive = ContentArchive::open(path);
+  ASSERT_NE(archive, nullptr);
+
+  const auto base = archive->find("a")->data();
+
+  for (const char* name : {"a", "b", "c"}) {
+    const auto offset = archive->find(name)->data() - base;
+    EXPECT_EQ(offset % kContentArchiveAlignment, 0) << name;
+  }
+}
+
+TEST(ContentArchiveTest, FindNormalizesPaths) {
+  const auto path = write_archive(
+      "forge_test_normalize.fpak",
+      {{"content/a.txt", "alpha"}});
+
+  auto archive = ContentArchive::open(path);
+  ASSERT_NE(archive, nullptr);
+
+  EXPECT_TRUE(archive->find("./content/a.txt").has_value());
+  EXPECT_TRUE(archive->find("content/sub/../a.txt").has_value());
+}
+
+TEST(ContentArchiveTest, MissingFileHasNoValue) {
+  const auto path = write_archive(
+      "forge_test_missing.fpak",
+      {{"content/a.txt", "alpha"}, {"content/c.txt", "charlie"}});
+
+  auto archive = ContentArchive::open(path);
+  ASSERT_NE(archive, nullptr);
+
+  EXPECT_FALSE(archive->find("content/b.txt").has_value());
+  EXPECT_FALSE(archive->find("content/z.txt").has_value());
+  EXPECT_FALSE(archive->find("").has_value());
+}
+
+TEST(ContentArchiveTest, RejectsFileWithoutMagic) {
+  const auto path = std::filesystem::temp_directory_path() /
+                    "forge_test_not_archive.fpak";
+  std::ofstream{path, std::ios::binary} << "this is not a content archive";
+
+  EXPECT_EQ(ContentArchive::open(path.string()), nullptr);
+}
+
+TEST(ContentArchiveTest, RejectsTruncatedArchive) {
+  const auto path = write_archive(
+      "forge_test_truncated.fpak",
+      {{"content/a.txt", "a much longer file than the archive has room for"}});
+
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+
+  EXPECT_EQ(ContentArchive::open(path), nullptr);
+}
@@ -0,0 +1,156 @@
+#include <forge/audio_mixer.h>
+#include <forge/content_cache.h>
+
+#include <gtest/gtest.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+  /// Creates audio that reports `size_in_bytes` without allocating samples,
+  /// since the cache only looks at the size.
+  std::unique_ptr<SdlAudioBuffer> make_audio(uint32_t size_in_bytes) {
+    auto audio = std::make_unique<SdlAudioBuffer>();
+    audio->size_in_bytes = size_in_bytes;
+    return audio;
+  }
+
+  /// Creates `frame_count` stereo F32 frames with every sample set to `value`.
+  std::unique_ptr<SdlAudioBuffer> make_sound(size_t frame_count, float value) {
+    const auto sample_count = frame_count * 2;
+
+    auto audio = std::make_unique<SdlAudioBuffer>();
+    audio->size_in_bytes =
+        static_cast<uint32_t>(sample_count * sizeof(float));
+    audio->data = static_cast<uint8_t*>(SDL_malloc(audio->size_in_bytes));
+
+    auto* samples = reinterpret_cast<float*>(audio->data);
+    std::fill(samples, samples + sample_count, value);
+
+    return audio;
+  }
+} // namespace
+
+TEST(ContentCacheTest, NormalizesPaths) {
+  EXPECT_EQ(
+      ContentCache::normalize_path("content/foo.png"),
+      "content/foo.png");
+  EXPECT_EQ(
+      ContentCache::normalize_path("content/../content/foo.png"),
+      "content/foo.png");
+  EXPECT_EQ(
+      ContentCache::normalize_path("content/./foo.png"),
+      "content/foo.png");
+  EXPECT_EQ(
+      ContentCache::normalize_path("content//foo.png"),
+      "content/foo.png");
+}
+
+TEST(ContentCacheTest, EquivalentPathsShareAnEntry) {
+  ContentCache cache;
+
+  const auto audio = cache.add_audio("content/a.ogg", make_audio(100));
+  EXPECT_EQ(cache.find_audio("content/../content/a.ogg"), audio);
+
+  // Adding the same file again keeps the first copy.
+  EXPECT_EQ(cache.add_audio("content/./a.ogg", make_audio(100)), audio);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.memory_used(), 100u);
+}
+
+TEST(ContentCacheTest, TrimEvictsLeastRecentlyUsedFirst) {
+  ContentCache cache(nullptr, 300);
+
+  cache.add_audio("a.ogg", make_audio(100));
+  cache.add_audio("b.ogg", make_audio(100));
+  cache.add_audio("c.ogg", make_audio(100));
+  EXPECT_EQ(cache.size(), 3u);
+  EXPECT_EQ(cache.memory_used(), 300u);
+
+  // Touching a makes b the least recently used entry.
+  EXPECT_NE(cache.find_audio("a.ogg"), nullptr);
+  cache.add_audio("d.ogg", make_audio(100));
+
+  EXPECT_EQ(cache.size(), 3u);
+  EXPECT_EQ(cache.memory_used(), 300u);
+  EXPECT_EQ(cache.find_audio("b.ogg"), nullptr);
+  EXPECT_NE(cache.find_audio("a.ogg"), nullptr);
+  EXPECT_NE(cache.find_audio("c.ogg"), nullptr);
+  EXPECT_NE(cache.find_audio("d.ogg"), nullptr);
+
+  // Shrinking the budget evicts down to it, least recently used first.
+  cache.set_memory_budget(150);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.memory_used(), 100u);
+  EXPECT_NE(cache.find_audio("d.ogg"), nullptr);
+}
+
+TEST(ContentCacheTest, TrimKeepsReferencedEntries) {
+  ContentCache cache(nullptr, 150);
+
+  auto a = cache.add_audio("a.ogg", make_audio(100));
+  const auto b = cache.add_audio("b.ogg", make_audio(100));
+
+  // Over budget, but both entries are still in use.
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.memory_used(), 200u);
+  EXPECT_EQ(cache.trim(), 0u);
+
+  a.reset();
+  EXPECT_EQ(cache.trim(), 1u);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.memory_used(), 100u);
+  EXPECT_EQ(cache.find_audio("b.ogg"), b);
+}
+
+TEST(ContentCacheTest, HeldAudioIsNotEvictedWhilePlaying) {
+  ContentCache cache(nullptr, 150);
+  AudioMixer mixer;
+
+  auto sound = cache.add_audio("pop.ogg", make_sound(64, 0.5f));
+  const auto voice = mixer.play(
+      {reinterpret_cast<const float*>(sound->data),
+       sound->size_in_bytes / sizeof(float)});
+
+  // Going over budget trims the cache, which must keep the playing sound
+  // while its handle is held.
+  cache.add_audio("other.ogg", make_audio(100));
+  EXPECT_EQ(cache.find_audio("pop.ogg"), sound);
+
+  std::vector<float> output(2 * 64);
+  mixer.mix(output);
+
+  for (auto sample : output) {
+    EXPECT_FLOAT_EQ(sample, 0.5f);
+  }
+
+  // Once the sound has finished the handle can be dropped and evicted.
+  EXPECT_FALSE(mixer.is_playing(voice));
+  sound.reset();
+  cache.trim();
+  EXPECT_EQ(cache.find_audio("pop.ogg"), nullptr);
+}
+
+TEST(ContentCacheTest, EvictUnreferencedIgnoresTheBudget) {
+  ContentCache cache;
+
+  cache.add_audio("a.ogg", make_audio(100));
+  cache.add_audio("b.ogg", make_audio(200));
+  const auto c = cache.add_audio("c.ogg", make_audio(300));
+  EXPECT_EQ(cache.memory_used(), 600u);
+
+  EXPECT_EQ(cache.evict_unreferenced(), 2u);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.memory_used(), 300u);
+  EXPECT_EQ(cache.find_audio("c.ogg"), c);
+}
+
+TEST(ContentCacheTest, TexturesNeedARenderer) {
+  ContentCache cache;
+
+  EXPECT_EQ(cache.texture("content/bubble.png"), nullptr);
+  EXPECT_EQ(cache.size(), 0u);
+}
@@ -0,0 +1,175 @@
+#include <forge/decode_cache.h>
+
+#include <gtest/gtest.h>
+
+#include "support/test_images.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+  std::span<const unsigned char> as_bytes(std::string_view text) {
+    return {reinterpret_cast<const unsigned char*>(text.data()), text.size()};
+  }
+
+  /// Creates an empty cache directory for one test, and returns its path with a
+  /// trailing separator.
+  std::string make_cache_directory(const std::string& name) {
+    const auto directory = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    return directory.string() + "/";
+  }
+
+  /// Moves the modification times of cache files written in the last minute
+  /// back by `age`, so tests can order entries without waiting on the clock.
+  void backdate_new_entries(
+      const std::string& directory,
+      std::chrono::hours age) {
+    const auto now = std::filesystem::file_time_type::clock::now();
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+      if (entry.last_write_time() > now - std::chrono::minutes(1)) {
+        std::filesystem::last_write_time(entry.path(), now - age);
+      }
+    }
+  }
+
+  size_t count_entries(const std::string& directory) {
+    const std::filesystem::directory_iterator entries(directory);
+    return std::distance(begin(entries), end(entries));
+  }
+} // namespace
+
+TEST(DecodeCacheTest, HashMatchesReferenceValues) {
+  EXPECT_EQ(hash_bytes({}), 0xEF46DB3751D8E999ull);
+  EXPECT_EQ(hash_bytes(as_bytes("abc")), 0x44BC2CF5AD770999ull);
+}
+
+TEST(DecodeCacheTest, HashDependsOnEveryByteAndSeed) {
+  // Long enough to use the striped loop and every tail step.
+  std::vector<unsigned char> bytes(77);
+
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<unsigned char>(i);
+  }
+
+  const auto hash = hash_bytes(bytes);
+  EXPECT_EQ(hash_bytes(bytes), hash);
+  EXPECT_NE(hash_bytes(bytes, 1), hash);
+
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] ^= 1;
+    EXPECT_NE(hash_bytes(bytes), hash) << "byte " << i;
+    bytes[i] ^= 1;
+  }
+}
+
+TEST(DecodeCacheTest, ImageRoundTrip) {
+  const DecodeCache cache(make_cache_directory("forge_decode_cache_image"));
+  const auto source = as_bytes("png bytes");
+  const auto image = make_test_image(5, 3);
+
+  EXPECT_FALSE(cache.find_image(source).has_value());
+  ASSERT_TRUE(cache.store_image(source, image));
+
+  const auto cached = cache.find_image(source);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->width, 5);
+  EXPECT_EQ(cached->height, 3);
+  EXPECT_EQ(
+      std::memcmp(cached->pixels.get(), image.pixels.get(), 5 * 3 * 4),
+      0);
+
+  // Different source bytes miss.
+  EXPECT_FALSE(cache.find_image(as_bytes("png bytez")).has_value());
+}
+
+TEST(DecodeCacheTest, AudioIsKeyedBySpec) {
+  const DecodeCache cache(make_cache_directory("forge_decode_cache_audio"));
+  const auto source = as_bytes("ogg bytes");
+
+  std::vector<float> samples{0.0f, 0.25f, -0.5f, 1.0f};
+  SdlAudioBuffer buffer;
+  buffer.spec = {.format = SDL_AUDIO_F32LE, .channels = 2, .freq = 44100};
+  buffer.size_in_bytes = static_cast<uint32_t>(samples.size() * sizeof(float));
+  buffer.data = reinterpret_cast<uint8_t*>(samples.data());
+
+  const auto stored = cache.store_audio(source, buffer);
+  buffer.data = nullptr; // Not owned by the buffer.
+  ASSERT_TRUE(stored);
+
+  const auto cached = cache.find_audio(source, buffer.spec);
+  ASSERT_NE(cached, nullptr);
+  EXPECT_EQ(cached->spec.format, SDL_AUDIO_F32LE);
+  EXPECT_EQ(cached->spec.channels, 2);
+  EXPECT_EQ(cached->spec.freq, 44100);
+  ASSERT_EQ(cached->size_in_bytes, samples.size() * sizeof(float));
+  EXPECT_EQ(
+      std::memcmp(cached->data, samples.data(), cached->size_in_bytes),
+      0);
+
+  auto other_spec = buffer.spec;
+  other_spec.freq = 48000;
+  EXPECT_EQ(cache.find_audio(source, other_spec), nullptr);
+}
+
+TEST(DecodeCacheTest, IgnoresTruncatedEntries) {
+  const auto directory = make_cache_directory("forge_decode_cache_truncated");
+  const DecodeCache cache(directory);
+  const auto source = as_bytes("png bytes");
+
+  ASSERT_TRUE(cache.store_image(source, make_test_image(4, 4)));
+
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    std::filesystem::resize_file(
+        entry.path(),
+        std::filesystem::file_size(entry.path()) - 1);
+  }
+
+  EXPECT_FALSE(cache.find_image(source).has_value());
+}
+
+TEST(DecodeCacheTest, TrimDeletesLeastRecentlyUsedEntries) {
+  const auto directory = make_cache_directory("forge_decode_cache_trim");
+  const auto first = as_bytes("first");
+  const auto second = as_bytes("second");
+  const auto third = as_bytes("third");
+
+  {
+    const DecodeCache cache(directory);
+    ASSERT_TRUE(cache.store_image(first, make_test_image(4, 4)));
+    backdate_new_entries(directory, std::chrono::hours(3));
+    ASSERT_TRUE(cache.store_image(second, make_test_image(4, 4)));
+    backdate_new_entries(directory, std::chrono::hours(2));
+    ASSERT_TRUE(cache.store_image(third, make_test_image(4, 4)));
+
+    // A hit makes the oldest entry the most recently used.
+    ASSERT_TRUE(cache.find_image(first).has_value());
+  }
+
+  // Each entry is a 48 byte header and 64 bytes of pixels, so trimming three
+  // entries down to 3/4 of 300 bytes deletes one of them.
+  const DecodeCache cache(directory, 300);
+  EXPECT_EQ(count_entries(directory), 2u);
+  EXPECT_TRUE(cache.find_image(first).has_value());
+  EXPECT_FALSE(cache.find_image(second).has_value());
+  EXPECT_TRUE(cache.find_image(third).has_value());
+}
+
+TEST(DecodeCacheTest, StoringOverTheSizeLimitTrims) {
+  const auto directory = make_cache_directory("forge_decode_cache_limit");
+  const DecodeCache cache(directory, 300);
+
+  ASSERT_TRUE(cache.store_image(as_bytes("first"), make_test_image(4, 4)));
+  ASSERT_TRUE(cache.store_image(as_bytes("second"), make_test_image(4, 4)));
+  EXPECT_EQ(cache.trim(), 0u);
+  EXPECT_EQ(count_entries(directory), 2u);
+
+  ASSERT_TRUE(cache.store_image(as_bytes("third"), make_test_image(4, 4)));
+  EXPECT_EQ(count_entries(directory), 2u);
+}
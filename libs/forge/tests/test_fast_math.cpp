@@ -0,0 +1,71 @@
+#include <forge/fast_math.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+  /// Evenly spaced inputs covering the accurate range of the fast functions.
+  std::vector<float> make_inputs(size_t count) {
+    std::vector<float> inputs(count);
+
+    for (size_t i = 0; i < count; ++i) {
+      inputs[i] = -kFastTrigMaxInput +
+                  2.0f * kFastTrigMaxInput * static_cast<float>(i) /
+                      static_cast<float>(count - 1);
+    }
+
+    return inputs;
+  }
+} // namespace
+
+TEST(FastMathTest, SinIsWithinErrorBound) {
+  for (const auto x : make_inputs(1000003)) {
+    ASSERT_NEAR(
+        fast_sin(x), std::sin(static_cast<double>(x)), kFastTrigMaxError)
+        << "x = " << x;
+  }
+}
+
+TEST(FastMathTest, CosIsWithinErrorBound) {
+  for (const auto x : make_inputs(1000003)) {
+    ASSERT_NEAR(
+        fast_cos(x), std::cos(static_cast<double>(x)), kFastTrigMaxError)
+        << "x = " << x;
+  }
+}
+
+TEST(FastMathTest, ExactAtSpecialValues) {
+  EXPECT_EQ(fast_sin(0.0f), 0.0f);
+  EXPECT_NEAR(fast_sin(1.5707963f), 1.0f, kFastTrigMaxError);
+  EXPECT_NEAR(fast_sin(-1.5707963f), -1.0f, kFastTrigMaxError);
+  EXPECT_NEAR(fast_cos(0.0f), 1.0f, kFastTrigMaxError);
+  EXPECT_NEAR(fast_cos(3.1415927f), -1.0f, kFastTrigMaxError);
+}
+
+TEST(FastMathTest, BulkMatchesScalar) {
+  // An odd count exercises the scalar tail after the SIMD loop.
+  const auto inputs = make_inputs(1001);
+  std::vector<float> sines(inputs.size());
+  std::vector<float> cosines(inputs.size());
+
+  fast_sin(inputs, sines);
+  fast_cos(inputs, cosines);
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    EXPECT_EQ(sines[i], fast_sin(inputs[i]));
+    EXPECT_EQ(cosines[i], fast_cos(inputs[i]));
+  }
+}
+
+TEST(FastMathTest, BulkSupportsInPlace) {
+  auto values = make_inputs(37);
+  const auto inputs = values;
+
+  fast_sin(values, values);
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], fast_sin(inputs[i]));
+  }
+}
@@ -0,0 +1,78 @@
+#include <forge/frame_arena.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+TEST(FrameArenaTest, AllocationsAreAlignedAndDistinct) {
+  FrameArena arena(1024);
+
+  auto* a = static_cast<unsigned char*>(arena.allocate(3, 1));
+  auto* b = static_cast<unsigned char*>(arena.allocate(8, 8));
+  auto* c = static_cast<unsigned char*>(arena.allocate(16, 64));
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 64, 0);
+  EXPECT_GE(b, a + 3);
+  EXPECT_GE(c, b + 8);
+  EXPECT_GE(arena.bytes_used(), 27);
+}
+
+TEST(FrameArenaTest, ResetReusesMemory) {
+  FrameArena arena(1024);
+
+  auto* first = arena.allocate(100);
+  arena.reset();
+
+  EXPECT_EQ(arena.bytes_used(), 0);
+  EXPECT_EQ(arena.allocate(100), first);
+  EXPECT_EQ(arena.high_water_mark(), 100);
+}
+
+TEST(FrameArenaTest, GrowsAndCoalescesBlocksOnReset) {
+  FrameArena arena(256);
+
+  // Overflow the first block several times, including with an allocation
+  // larger than a whole block.
+  for (int i = 0; i < 10; ++i) {
+    auto* values = arena.allocate_array<uint32_t>(32);
+    values[31] = i;
+  }
+
+  arena.allocate(1000);
+
+  const auto capacity = arena.capacity();
+  EXPECT_GT(capacity, 256);
+
+  // After a reset the same amount of work fits in the first block.
+  arena.reset();
+  EXPECT_EQ(arena.capacity(), capacity);
+
+  auto* start =
+      reinterpret_cast<std::byte*>(arena.allocate_array<uint32_t>(32));
+
+  for (int i = 1; i < 10; ++i) {
+    arena.allocate_array<uint32_t>(32);
+  }
+
+  auto* end = static_cast<std::byte*>(arena.allocate(1000));
+  EXPECT_LT(end - start, static_cast<ptrdiff_t>(capacity));
+  EXPECT_EQ(arena.capacity(), capacity);
+}
+
+TEST(FrameArenaTest, ResourceBacksPmrContainers) {
+  FrameArena arena(4096);
+  FrameArenaResource resource(arena);
+
+  std::pmr::vector<int> values{&resource};
+
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+
+  EXPECT_EQ(values[99], 99);
+  EXPECT_GE(arena.bytes_used(), 100 * sizeof(int));
+  EXPECT_TRUE(resource.is_equal(resource));
+  EXPECT_FALSE(resource.is_equal(*std::pmr::new_delete_resource()));
+}
@@ -0,0 +1,89 @@
+#include <forge/frame_profiler.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST(TimingHistogramTest, BucketsCoverEveryDuration) {
+  // Every bucket's lower bound must map back to the same bucket, and the
+  // buckets must be in increasing order.
+  for (size_t i = 0; i < TimingHistogram::kBucketCount; ++i) {
+    const auto lower = TimingHistogram::bucket_lower_bound(i);
+    EXPECT_EQ(TimingHistogram::bucket_index(lower), i);
+
+    if (i > 0) {
+      EXPECT_EQ(TimingHistogram::bucket_index(lower - 1), i - 1);
+    }
+  }
+}
+
+TEST(TimingHistogramTest, HugeDurationsUseLastBucket) {
+  EXPECT_EQ(
+      TimingHistogram::bucket_index(UINT64_MAX),
+      TimingHistogram::kBucketCount - 1);
+}
+
+TEST(TimingHistogramTest, EmptyHistogramSummary) {
+  TimingHistogram histogram;
+  const auto summary = histogram.summarize();
+
+  EXPECT_EQ(summary.count, 0);
+  EXPECT_EQ(summary.p99_ms, 0.0);
+  EXPECT_EQ(histogram.percentile_ns(0.5), 0);
+}
+
+TEST(TimingHistogramTest, PercentilesAreWithinBucketError) {
+  TimingHistogram histogram;
+
+  // Record 1 ms to 100 ms in 1 ms steps.
+  for (uint64_t ms = 1; ms <= 100; ++ms) {
+    histogram.record(ms * 1'000'000);
+  }
+
+  const auto summary = histogram.summarize();
+
+  EXPECT_EQ(summary.count, 100);
+  EXPECT_DOUBLE_EQ(summary.min_ms, 1.0);
+  EXPECT_DOUBLE_EQ(summary.max_ms, 100.0);
+  EXPECT_DOUBLE_EQ(summary.average_ms, 50.5);
+  EXPECT_NEAR(summary.p50_ms, 50.0, 50.0 * 0.07);
+  EXPECT_NEAR(summary.p95_ms, 95.0, 95.0 * 0.07);
+  EXPECT_NEAR(summary.p99_ms, 99.0, 99.0 * 0.07);
+}
+
+TEST(TimingHistogramTest, ResetClearsEverything) {
+  TimingHistogram histogram;
+  histogram.record(1000);
+  histogram.record(2000);
+  histogram.reset();
+
+  EXPECT_EQ(histogram.count(), 0);
+  EXPECT_EQ(histogram.summarize().count, 0);
+
+  histogram.record(5000);
+  EXPECT_DOUBLE_EQ(histogram.summarize().min_ms, 0.005);
+}
+
+TEST(TimingHistogramTest, ConcurrentRecordsAreCounted) {
+  TimingHistogram histogram;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&histogram, t] {
+      for (uint64_t i = 0; i < 10000; ++i) {
+        histogram.record(1000 + i + t);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto summary = histogram.summarize();
+
+  EXPECT_EQ(summary.count, 40000);
+  EXPECT_DOUBLE_EQ(summary.min_ms, 0.001);
+  EXPECT_DOUBLE_EQ(summary.max_ms, (1000 + 9999 + 3) / 1e6);
+}
@@ -0,0 +1,205 @@
+#include <forge/game.h>
+
+#include <gtest/gtest.h>
+
+namespace {
+  constexpr Uint64 kScaledLagPerUpdate = SDL_NS_PER_SECOND;
+  constexpr Uint32 kRate = 60;
+  constexpr Uint64 kMaxUpdates = 5;
+
+  /// Half an update of scaled lag left over from the previous frame.
+  constexpr Uint64 kHalfUpdate = kScaledLagPerUpdate / 2;
+
+  /// A one second stall at 60 Hz, which with the half update owes 60.5
+  /// updates.
+  constexpr Uint64 kStallNs = SDL_NS_PER_SECOND;
+
+  /// Runs the fixed timestep loop on a simulated clock without initializing
+  /// any subsystems, and counts what the loop calls.
+  class LoopGame : public Game {
+  public:
+    LoopGame() : Game(nullptr, nullptr) {
+      set_clock([this] { return time_ns_; });
+
+      // The first frame only starts the clock.
+      iterate();
+    }
+
+    /// Advances the clock by `frame_time_ns` and runs one frame.
+    void run_frame(Uint64 frame_time_ns) {
+      time_ns_ += frame_time_ns;
+      iterate();
+    }
+
+    Uint64 update_count() const { return update_count_; }
+    float extrapolation() const { return extrapolation_; }
+
+  protected:
+    SDL_AppResult on_update(float /*delta_s*/) override {
+      update_count_++;
+      return SDL_APP_CONTINUE;
+    }
+
+    SDL_AppResult
+        on_render(float /*delta_s*/, float extrapolation) override {
+      extrapolation_ = extrapolation;
+      return SDL_APP_CONTINUE;
+    }
+
+  private:
+    Uint64 time_ns_ = 1;
+    Uint64 update_count_ = 0;
+    float extrapolation_ = 0.0f;
+  };
+} // namespace
+
+TEST(CatchUpPlanTest, EveryPolicyKeepsUpWithinTheLimit) {
+  for (const auto policy :
+       {CatchUpPolicy::Clamp, CatchUpPolicy::Drop, CatchUpPolicy::SlowMotion}) {
+    // 50 ms at 60 Hz is three whole updates.
+    const auto plan =
+        plan_catch_up(kHalfUpdate, 50'000'000, kRate, kMaxUpdates, policy);
+
+    EXPECT_EQ(plan.updates_owed, 3u);
+    EXPECT_EQ(plan.scaled_lag, 3 * kScaledLagPerUpdate + kHalfUpdate);
+    EXPECT_EQ(plan.elapsed_time_ns, 50'000'000u);
+    EXPECT_EQ(plan.dropped_updates, 0u);
+    EXPECT_EQ(plan.clamped_time_ns, 0u);
+  }
+}
+
+TEST(CatchUpPlanTest, ClampShortensTheFrame) {
+  const auto plan = plan_catch_up(
+      kHalfUpdate,
+      kStallNs,
+      kRate,
+      kMaxUpdates,
+      CatchUpPolicy::Clamp);
+
+  EXPECT_EQ(plan.updates_owed, 60u);
+
+  // Exactly the most updates allowed are owed, with no partial update.
+  EXPECT_EQ(plan.scaled_lag, kMaxUpdates * kScaledLagPerUpdate);
+
+  // The frame only covers the 4.5 updates it now simulates.
+  EXPECT_EQ(plan.elapsed_time_ns, 75'000'000u);
+  EXPECT_EQ(plan.clamped_time_ns, 925'000'000u);
+  EXPECT_EQ(plan.dropped_updates, 0u);
+}
+
+TEST(CatchUpPlanTest, DropDiscardsWholeUpdates) {
+  const auto plan = plan_catch_up(
+      kHalfUpdate,
+      kStallNs,
+      kRate,
+      kMaxUpdates,
+      CatchUpPolicy::Drop);
+
+  EXPECT_EQ(plan.updates_owed, 60u);
+
+  // The partial update is kept, so rendering stays in phase with real time.
+  EXPECT_EQ(plan.scaled_lag, kMaxUpdates * kScaledLagPerUpdate + kHalfUpdate);
+  EXPECT_EQ(plan.elapsed_time_ns, kStallNs);
+  EXPECT_EQ(plan.dropped_updates, 55u);
+  EXPECT_EQ(plan.clamped_time_ns, 0u);
+}
+
+TEST(CatchUpPlanTest, SlowMotionCarriesOneFrameOfUpdates) {
+  const auto plan = plan_catch_up(
+      kHalfUpdate,
+      kStallNs,
+      kRate,
+      kMaxUpdates,
+      CatchUpPolicy::SlowMotion);
+
+  EXPECT_EQ(plan.updates_owed, 60u);
+  EXPECT_EQ(
+      plan.scaled_lag,
+      2 * kMaxUpdates * kScaledLagPerUpdate + kHalfUpdate);
+  EXPECT_EQ(plan.elapsed_time_ns, kStallNs);
+  EXPECT_EQ(plan.dropped_updates, 50u);
+  EXPECT_EQ(plan.clamped_time_ns, 0u);
+}
+
+TEST(CatchUpPlanTest, SlowMotionDropsNothingUntilTwoFramesAreOwed) {
+  // 140 ms at 60 Hz is 8.4 updates, which later frames can catch up on.
+  const auto plan = plan_catch_up(
+      0,
+      140'000'000,
+      kRate,
+      kMaxUpdates,
+      CatchUpPolicy::SlowMotion);
+
+  EXPECT_EQ(plan.updates_owed, 8u);
+  EXPECT_EQ(plan.scaled_lag, 8 * kScaledLagPerUpdate + 400'000'000);
+  EXPECT_EQ(plan.dropped_updates, 0u);
+}
+
+TEST(GameLoopTest, UpdateCountsAreExact) {
+  // Frame times that are not a whole number of updates, so any rounding in
+  // the accumulated lag would add up over the run.
+  const struct {
+    Uint32 update_rate_hz;
+    Uint64 frame_time_ns;
+  } cases[] = {
+      {60, SDL_NS_PER_SECOND / 144},
+      {60, SDL_NS_PER_SECOND / 144 + 1},
+      {144, SDL_NS_PER_SECOND / 60},
+      {144, SDL_NS_PER_SECOND / 60 + 1},
+  };
+
+  for (const auto& test_case : cases) {
+    LoopGame game;
+    game.set_update_rate(test_case.update_rate_hz);
+
+    // Ten minutes of frames.
+    const Uint64 frame_count =
+        600 * SDL_NS_PER_SECOND / test_case.frame_time_ns;
+
+    for (Uint64 frame = 0; frame < frame_count; ++frame) {
+      game.run_frame(test_case.frame_time_ns);
+    }
+
+    const auto elapsed_ns = frame_count * test_case.frame_time_ns;
+    EXPECT_EQ(
+        game.update_count(),
+        elapsed_ns * test_case.update_rate_hz / SDL_NS_PER_SECOND)
+        << test_case.update_rate_hz << " Hz, " << test_case.frame_time_ns
+        << " ns frames";
+    EXPECT_EQ(game.loop_stats().overruns, 0u);
+  }
+}
+
+TEST(GameLoopTest, ChangingTheRateKeepsThePendingTime) {
+  LoopGame game;
+  game.set_update_rate(60);
+
+  // A little over two and a half updates at 60 Hz.
+  game.run_frame(41'666'667);
+  EXPECT_EQ(game.update_count(), 2u);
+  EXPECT_NEAR(game.extrapolation(), 0.5f, 1e-6f);
+
+  // The half update left over is one whole update at 120 Hz, which the next
+  // frame runs even though no time has passed.
+  game.set_update_rate(120);
+  game.run_frame(0);
+  EXPECT_EQ(game.update_count(), 3u);
+  EXPECT_NEAR(game.extrapolation(), 0.0f, 1e-6f);
+
+  // A quarter of a 120 Hz update is an eighth of a 30 Hz update.
+  game.run_frame(SDL_NS_PER_SECOND / 480);
+  EXPECT_EQ(game.update_count(), 3u);
+  EXPECT_NEAR(game.extrapolation(), 0.25f, 1e-6f);
+
+  game.set_update_rate(30);
+  game.run_frame(0);
+  EXPECT_EQ(game.update_count(), 3u);
+  EXPECT_NEAR(game.extrapolation(), 0.0625f, 1e-6f);
+
+  // Back at 60 Hz the eighth of an update is still owed, so another update's
+  // worth of time runs one update and leaves an eighth over.
+  game.set_update_rate(60);
+  game.run_frame(SDL_NS_PER_SECOND / 60);
+  EXPECT_EQ(game.update_count(), 4u);
+  EXPECT_NEAR(game.extrapolation(), 0.125f, 1e-6f);
+}
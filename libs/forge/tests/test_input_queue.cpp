@@ -0,0 +1,58 @@
+#include <forge/input_queue.h>
+
+#include <gtest/gtest.h>
+
+TEST(InputQueueTest, KeepsPointerEventsInOrder) {
+  InputQueue queue;
+
+  queue.push_pointer(PointerEventType::MouseClick, 1, 2);
+  queue.push_pointer(PointerEventType::TouchDown, 3, 4);
+  queue.push_pointer(PointerEventType::MouseClick, 5, 6);
+
+  const auto events = queue.pointer_events();
+  ASSERT_EQ(events.size(), 3);
+  EXPECT_EQ(events[0].type, PointerEventType::MouseClick);
+  EXPECT_EQ(events[0].x, 1);
+  EXPECT_EQ(events[0].y, 2);
+  EXPECT_EQ(events[1].type, PointerEventType::TouchDown);
+  EXPECT_EQ(events[1].x, 3);
+  EXPECT_EQ(events[2].y, 6);
+  EXPECT_FALSE(queue.pending_resize().has_value());
+}
+
+TEST(InputQueueTest, CoalescesResizes) {
+  InputQueue queue;
+  EXPECT_TRUE(queue.empty());
+
+  queue.push_resize(640, 480);
+  queue.push_resize(800, 600);
+  queue.push_resize(1024, 768);
+
+  ASSERT_TRUE(queue.pending_resize().has_value());
+  EXPECT_EQ(queue.pending_resize()->width, 1024);
+  EXPECT_EQ(queue.pending_resize()->height, 768);
+  EXPECT_TRUE(queue.pointer_events().empty());
+  EXPECT_FALSE(queue.empty());
+}
+
+TEST(InputQueueTest, ClearKeepsReservedSpace) {
+  InputQueue queue(4);
+
+  for (int i = 0; i < 4; ++i) {
+    queue.push_pointer(PointerEventType::TouchDown, i, i);
+  }
+
+  queue.push_resize(10, 10);
+  const auto* storage = queue.pointer_events().data();
+  queue.clear();
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.pending_resize().has_value());
+
+  // Refilling up to the reserved capacity reuses the same storage.
+  for (int i = 0; i < 4; ++i) {
+    queue.push_pointer(PointerEventType::MouseClick, i, i);
+  }
+
+  EXPECT_EQ(queue.pointer_events().data(), storage);
+}
@@ -0,0 +1,111 @@
+#include <forge/job_system.h>
+#include <forge/particle_store.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+TEST(JobSystemTest, ParallelForVisitsEveryIndexOnce) {
+  JobSystem jobs(3);
+  std::vector<std::atomic<int>> visits(10007);
+
+  jobs.parallel_for(0, visits.size(), 64, [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      visits[i]++;
+    }
+  });
+
+  for (const auto& count : visits) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(JobSystemTest, WaitRunsJobsWithoutWorkers) {
+  JobSystem jobs(1);
+  JobSystem inline_jobs(0);
+  JobCounter counter;
+  std::atomic<int> sum{0};
+
+  // Waiting finishes the work whether or not there are workers to help.
+  for (auto* system : {&jobs, &inline_jobs}) {
+    for (int i = 1; i <= 100; ++i) {
+      system->run([&sum, i] { sum += i; }, &counter);
+    }
+
+    system->wait(counter);
+  }
+
+  EXPECT_TRUE(counter.done());
+  EXPECT_EQ(sum.load(), 2 * 5050);
+}
+
+TEST(JobSystemTest, RunAfterWaitsForDependency) {
+  JobSystem jobs(4);
+  JobCounter first;
+  JobCounter second;
+  std::atomic<int> finished_first{0};
+  std::atomic<int> seen_by_second{-1};
+
+  for (int i = 0; i < 50; ++i) {
+    jobs.run([&] { finished_first++; }, &first);
+  }
+
+  jobs.run_after(
+      first,
+      [&] { seen_by_second = finished_first.load(); },
+      &second);
+  jobs.wait(second);
+
+  EXPECT_EQ(seen_by_second.load(), 50);
+
+  // A dependency that is already done starts the job straight away.
+  jobs.run_after(first, [&] { seen_by_second = 0; }, &second);
+  jobs.wait(second);
+  EXPECT_EQ(seen_by_second.load(), 0);
+}
+
+TEST(JobSystemTest, JobsCanWaitOnNestedJobs) {
+  JobSystem jobs(2);
+  std::atomic<int> leaves{0};
+
+  jobs.parallel_for(0, 8, 1, [&](size_t, size_t) {
+    jobs.parallel_for(0, 8, 1, [&](size_t, size_t) { leaves++; });
+  });
+
+  EXPECT_EQ(leaves.load(), 64);
+}
+
+TEST(JobSystemTest, ParallelIntegrateMatchesSerial) {
+  JobSystem jobs(3);
+  ParticleStore serial;
+  ParticleStore parallel;
+
+  // Every third particle starts past the despawn line.
+  const auto count = ParticleStore::kParallelChunkSize * 3 + 5;
+
+  for (size_t i = 0; i < count; ++i) {
+    const ParticleDesc desc{
+        .x = static_cast<float>(i),
+        .y = (i % 3 == 0) ? 500.0f : 0.0f,
+        .size = 10.0f,
+        .speed = 20.0f,
+        .wobble_amplitude = 1.0f,
+        .wobble_phase = static_cast<float>(i % 7),
+    };
+
+    serial.spawn(desc);
+    parallel.spawn(desc);
+  }
+
+  EXPECT_EQ(
+      serial.integrate(0.5f, 1.0f, 100.0f),
+      parallel.integrate(0.5f, 1.0f, 100.0f, jobs));
+
+  ASSERT_EQ(serial.size(), parallel.size());
+
+  for (size_t i = 0; i < serial.size(); ++i) {
+    EXPECT_EQ(serial.x_positions()[i], parallel.x_positions()[i]);
+    EXPECT_EQ(serial.y_positions()[i], parallel.y_positions()[i]);
+  }
+}
@@ -0,0 +1,232 @@
+// Only keep warnings and errors so the test can check that filtered calls are
+// compiled out.
+#define FORGE_MIN_LOG_LEVEL FORGE_LOG_LEVEL_WARN
+#include <forge/log.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  /// Collects every message passed to SDL's log output while alive.
+  class LogCapture {
+  public:
+    LogCapture() {
+      SDL_GetLogOutputFunction(&previous_function_, &previous_userdata_);
+      SDL_SetLogOutputFunction(&LogCapture::output, this);
+    }
+
+    ~LogCapture() {
+      SDL_SetLogOutputFunction(previous_function_, previous_userdata_);
+    }
+
+    std::vector<std::string> messages() {
+      std::lock_guard lock(mutex_);
+      return messages_;
+    }
+
+  private:
+    static void output(
+        void* userdata,
+        int,
+        SDL_LogPriority,
+        const char* message) {
+      auto* capture = static_cast<LogCapture*>(userdata);
+      std::lock_guard lock(capture->mutex_);
+      capture->messages_.emplace_back(message);
+    }
+
+  private:
+    SDL_LogOutputFunction previous_function_ = nullptr;
+    void* previous_userdata_ = nullptr;
+    std::mutex mutex_;
+    std::vector<std::string> messages_;
+  };
+} // namespace
+
+TEST(LogTest, WritesImmediatelyWithoutAsyncLogging) {
+  LogCapture capture;
+
+  FORGE_LOG_WARN(SDL_LOG_CATEGORY_APPLICATION, "value %d", 42);
+
+  const auto messages = capture.messages();
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0], "value 42");
+}
+
+TEST(LogTest, FilteredLevelsDoNotEvaluateArguments) {
+  LogCapture capture;
+  int evaluated = 0;
+
+  FORGE_LOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "%d", ++evaluated);
+  FORGE_LOG_INFO(SDL_LOG_CATEGORY_APPLICATION, "%d", ++evaluated);
+  FORGE_LOG_ERROR(SDL_LOG_CATEGORY_APPLICATION, "%d", ++evaluated);
+
+  EXPECT_EQ(evaluated, 1);
+  EXPECT_EQ(capture.messages().size(), 1);
+}
+
+TEST(LogTest, AsyncLoggingWritesEveryThreadsMessages) {
+  LogCapture capture;
+  start_async_logging();
+
+  // Stay under the queue capacity even if the flush thread never runs.
+  constexpr int kThreadCount = 4;
+  constexpr int kMessagesPerThread = 200;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < kThreadCount; ++t) {
+    threads.emplace_back([t] {
+      for (int i = 0; i < kMessagesPerThread; ++i) {
+        FORGE_LOG_WARN(SDL_LOG_CATEGORY_APPLICATION, "thread %d %d", t, i);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  stop_async_logging();
+
+  const auto messages = capture.messages();
+  ASSERT_EQ(messages.size(), kThreadCount * kMessagesPerThread);
+
+  // Each thread's messages arrive in the order it logged them.
+  std::vector<int> next(kThreadCount, 0);
+
+  for (const auto& message : messages) {
+    int t = 0;
+    int i = 0;
+    ASSERT_EQ(std::sscanf(message.c_str(), "thread %d %d", &t, &i), 2);
+    EXPECT_EQ(i, next[t]++);
+  }
+}
+
+TEST(LogTest, FlushThreadWakesForNewMessages) {
+  LogCapture capture;
+  start_async_logging();
+
+  // Let the flush thread go to sleep on an empty queue first.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  FORGE_LOG_WARN(SDL_LOG_CATEGORY_APPLICATION, "wake up");
+
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+  while (capture.messages().empty() &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+
+  // Written by the flush thread rather than by stopping.
+  EXPECT_EQ(capture.messages().size(), 1);
+  stop_async_logging();
+  EXPECT_EQ(capture.messages().size(), 1);
+}
+
+TEST(LogTest, StoppingWhileThreadsLogKeepsEveryMessage) {
+  LogCapture capture;
+  const auto dropped_before = log_dropped_count();
+
+  constexpr int kThreadCount = 4;
+  constexpr int kMessagesPerThread = 2000;
+  std::atomic<int> started = 0;
+  std::vector<std::thread> threads;
+
+  for (int round = 0; round < 20; ++round) {
+    start_async_logging();
+    started = 0;
+
+    for (int t = 0; t < kThreadCount; ++t) {
+      threads.emplace_back([&started, t] {
+        started++;
+
+        for (int i = 0; i < kMessagesPerThread; ++i) {
+          FORGE_LOG_WARN(SDL_LOG_CATEGORY_APPLICATION, "thread %d %d", t, i);
+        }
+      });
+    }
+
+    // Stop while the threads are still logging. Messages logged after this
+    // are written immediately.
+    while (started < kThreadCount) {
+      std::this_thread::yield();
+    }
+
+    stop_async_logging();
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    threads.clear();
+  }
+
+  // Every message was written, or dropped because the queue was full.
+  const auto dropped = log_dropped_count() - dropped_before;
+  size_t written = 0;
+
+  for (const auto& message : capture.messages()) {
+    if (message.starts_with("thread ")) {
+      written++;
+    }
+  }
+
+  EXPECT_EQ(written + dropped, 20u * kThreadCount * kMessagesPerThread);
+}
+
+TEST(LogTest, TruncatesLongMessages) {
+  LogCapture capture;
+  start_async_logging();
+
+  const std::string long_text(kMaxLogMessageLength * 2, 'x');
+  FORGE_LOG_WARN(SDL_LOG_CATEGORY_APPLICATION, "%s", long_text.c_str());
+
+  stop_async_logging();
+
+  const auto messages = capture.messages();
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0].size(), kMaxLogMessageLength - 1);
+}
+
+TEST(LogTest, DropsMessagesWhenFull) {
+  LogCapture capture;
+  const auto dropped_before = log_dropped_count();
+  start_async_logging();
+
+  // Log faster than the flush thread can keep up with, at least once the
+  // queue is full.
+  const auto message_count = static_cast<int>(kLogQueueCapacity * 4);
+
+  for (int i = 0; i < message_count; ++i) {
+    FORGE_LOG_WARN(SDL_LOG_CATEGORY_APPLICATION, "%d", i);
+  }
+
+  stop_async_logging();
+
+  const auto dropped = log_dropped_count() - dropped_before;
+  uint64_t reported_dropped = 0;
+  size_t written = 0;
+
+  for (const auto& message : capture.messages()) {
+    unsigned long long count = 0;
+
+    if (std::sscanf(message.c_str(), "log queue was full, dropped %llu", &count)
+        == 1) {
+      reported_dropped += count;
+    } else {
+      written++;
+    }
+  }
+
+  // Every message was either written or dropped, and every drop was reported.
+  EXPECT_EQ(written + dropped, static_cast<uint64_t>(message_count));
+  EXPECT_EQ(reported_dropped, dropped);
+}
@@ -0,0 +1,83 @@
+#include <forge/mip_chain.h>
+
+#include <gtest/gtest.h>
+
+#include "support/test_images.h"
+
+TEST(MipChainTest, DownsampleAveragesEachBlock) {
+  // Cover widths that exercise both the SIMD loop and the scalar tail, along
+  // with odd sizes that drop the last row and column.
+  for (const auto width : {2, 7, 8, 9, 16, 33, 64}) {
+    const auto height = width + 3;
+    const auto image = make_test_image(width, height, width);
+    const auto half = downsample_image(image);
+
+    ASSERT_NE(half.pixels, nullptr);
+    ASSERT_EQ(half.width, width / 2);
+    ASSERT_EQ(half.height, height / 2);
+
+    const auto* in = image.pixels.get();
+    const auto pixel = [&](int x, int y, int c) {
+      return static_cast<int>(in[(y * width + x) * 4 + c]);
+    };
+
+    for (int y = 0; y < half.height; ++y) {
+      for (int x = 0; x < half.width; ++x) {
+        for (int c = 0; c < 4; ++c) {
+          const auto expected =
+              (pixel(2 * x, 2 * y, c) + pixel(2 * x + 1, 2 * y, c) +
+               pixel(2 * x, 2 * y + 1, c) + pixel(2 * x + 1, 2 * y + 1, c) +
+               2) /
+              4;
+
+          ASSERT_EQ(half.pixels.get()[(y * half.width + x) * 4 + c], expected)
+              << "width " << width << " at " << x << ", " << y;
+        }
+      }
+    }
+  }
+}
+
+TEST(MipChainTest, DownsampleThinImages) {
+  const auto row = downsample_image(make_test_image(5, 1, 1));
+  EXPECT_EQ(row.width, 2);
+  EXPECT_EQ(row.height, 1);
+
+  const auto column = downsample_image(make_test_image(1, 4, 2));
+  EXPECT_EQ(column.width, 1);
+  EXPECT_EQ(column.height, 2);
+
+  const auto pixel = downsample_image(make_test_image(1, 1, 3));
+  EXPECT_EQ(pixel.width, 1);
+  EXPECT_EQ(pixel.height, 1);
+
+  EXPECT_EQ(downsample_image(DecodedImage{}).pixels, nullptr);
+}
+
+TEST(MipChainTest, BuildsLevelsDownToMinimumSize) {
+  MipChain mips(make_test_image(512, 256, 4), 48);
+
+  // 512x256, 256x128, 128x64 and stop before 64x32.
+  ASSERT_EQ(mips.level_count(), 3);
+  EXPECT_EQ(mips.level(2).width, 128);
+  EXPECT_EQ(mips.level(2).height, 64);
+
+  EXPECT_EQ(MipChain(DecodedImage{}).level_count(), 0);
+}
+
+TEST(MipChainTest, PicksSmallestLevelCoveringDestination) {
+  // Levels are 512, 256, 128, 64 and 32 pixels wide.
+  EXPECT_EQ(mip_level_for(512, 512, 5, 600.0f, 600.0f), 0);
+  EXPECT_EQ(mip_level_for(512, 512, 5, 512.0f, 512.0f), 0);
+  EXPECT_EQ(mip_level_for(512, 512, 5, 300.0f, 300.0f), 0);
+  EXPECT_EQ(mip_level_for(512, 512, 5, 128.0f, 128.0f), 2);
+  EXPECT_EQ(mip_level_for(512, 512, 5, 72.0f, 72.0f), 2);
+  EXPECT_EQ(mip_level_for(512, 512, 5, 48.0f, 48.0f), 3);
+  EXPECT_EQ(mip_level_for(512, 512, 5, 1.0f, 1.0f), 4);
+
+  // The larger axis decides the level for non-square destinations.
+  EXPECT_EQ(mip_level_for(512, 512, 5, 32.0f, 200.0f), 1);
+
+  // Never step past the last level.
+  EXPECT_EQ(mip_level_for(512, 512, 2, 1.0f, 1.0f), 1);
+}
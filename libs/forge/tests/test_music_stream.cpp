@@ -0,0 +1,98 @@
+#include <forge/music_stream.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+// These tests read the game's own content files, which the build copies next
+// to the test executable.
+constexpr const char* kOggFilename = "content/pop.ogg";
+
+namespace {
+  /// Reads a stream to the end in blocks of `block_frames` frames.
+  std::vector<float> read_all(MusicStream& music, size_t block_frames) {
+    const auto channels = static_cast<size_t>(music.spec().channels);
+    std::vector<float> samples;
+    std::vector<float> block(block_frames * channels);
+
+    while (true) {
+      const auto frames = music.read(block);
+      samples.insert(
+          samples.end(),
+          block.begin(),
+          block.begin() + static_cast<ptrdiff_t>(frames * channels));
+
+      if (frames < block_frames) {
+        return samples;
+      }
+    }
+  }
+} // namespace
+
+TEST(MusicStreamTest, OpensOgg) {
+  const auto music = MusicStream::open(kOggFilename, false);
+  ASSERT_NE(music, nullptr);
+
+  EXPECT_EQ(music->spec().format, SDL_AUDIO_F32);
+  EXPECT_GT(music->spec().channels, 0);
+  EXPECT_GT(music->spec().freq, 0);
+  EXPECT_FALSE(music->finished());
+
+  EXPECT_EQ(MusicStream::open("content/missing.ogg", false), nullptr);
+}
+
+TEST(MusicStreamTest, BlockSizeDoesNotChangeSamples) {
+  const auto whole = MusicStream::open(kOggFilename, false);
+  const auto blocks = MusicStream::open(kOggFilename, false);
+  ASSERT_NE(whole, nullptr);
+  ASSERT_NE(blocks, nullptr);
+
+  const auto expected = read_all(*whole, 1 << 20);
+  const auto samples = read_all(*blocks, 100);
+
+  ASSERT_FALSE(expected.empty());
+  EXPECT_EQ(samples, expected);
+}
+
+TEST(MusicStreamTest, NonLoopingStreamFinishes) {
+  const auto music = MusicStream::open(kOggFilename, false);
+  ASSERT_NE(music, nullptr);
+
+  const auto channels = static_cast<size_t>(music->spec().channels);
+  const auto samples = read_all(*music, 256);
+  const auto frame_count = samples.size() / channels;
+  EXPECT_TRUE(music->finished());
+
+  // Reads past the end produce nothing.
+  std::vector<float> block(256 * channels);
+  EXPECT_EQ(music->read(block), 0u);
+  EXPECT_TRUE(music->finished());
+
+  // Rewinding plays the file again from the start.
+  music->rewind();
+  EXPECT_FALSE(music->finished());
+  EXPECT_EQ(read_all(*music, 256).size() / channels, frame_count);
+}
+
+TEST(MusicStreamTest, LoopingStreamWrapsAround) {
+  const auto once = MusicStream::open(kOggFilename, false);
+  const auto music = MusicStream::open(kOggFilename, true);
+  ASSERT_NE(once, nullptr);
+  ASSERT_NE(music, nullptr);
+
+  const auto channels = static_cast<size_t>(music->spec().channels);
+  const auto expected = read_all(*once, 256);
+  const auto frame_count = expected.size() / channels;
+  ASSERT_GT(frame_count, 0u);
+
+  // A single read spanning two and a half plays of the file is filled
+  // completely, repeating the file each time it wraps.
+  std::vector<float> samples(frame_count * 5 / 2 * channels);
+  EXPECT_EQ(music->read(samples), samples.size() / channels);
+  EXPECT_FALSE(music->finished());
+
+  for (size_t i = 0; i < samples.size(); ++i) {
+    ASSERT_EQ(samples[i], expected[i % expected.size()]) << "sample " << i;
+  }
+}
@@ -0,0 +1,147 @@
+#include <forge/particle_store.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST(ParticleStoreTest, SpawnAppendsParticle) {
+  ParticleStore store;
+
+  EXPECT_EQ(store.spawn({.x = 1.0f, .y = 2.0f, .size = 3.0f}), 0);
+  EXPECT_EQ(store.spawn({.x = 4.0f, .y = 5.0f, .size = 6.0f}), 1);
+
+  ASSERT_EQ(store.size(), 2);
+  EXPECT_EQ(store.x_positions()[1], 4.0f);
+  EXPECT_EQ(store.y_positions()[1], 5.0f);
+  EXPECT_EQ(store.sizes()[1], 6.0f);
+}
+
+TEST(ParticleStoreTest, SwapRemoveMovesLastParticle) {
+  ParticleStore store;
+
+  store.spawn({.x = 1.0f});
+  store.spawn({.x = 2.0f});
+  store.spawn({.x = 3.0f});
+  store.swap_remove(0);
+
+  ASSERT_EQ(store.size(), 2);
+  EXPECT_EQ(store.x_positions()[0], 3.0f);
+  EXPECT_EQ(store.x_positions()[1], 2.0f);
+}
+
+TEST(ParticleStoreTest, ClearRemovesEveryParticle) {
+  ParticleStore store;
+
+  store.spawn({.y = 200.0f});
+  store.spawn({.y = 0.0f});
+  EXPECT_EQ(store.integrate(1.0f, 0.0f, 100.0f), 1);
+
+  store.clear();
+  EXPECT_EQ(store.size(), 0);
+
+  // Nothing from before the clear is removed from new particles.
+  store.spawn({.x = 5.0f, .y = 0.0f});
+  EXPECT_EQ(store.integrate(1.0f, 0.0f, 100.0f), 0);
+  ASSERT_EQ(store.size(), 1);
+  EXPECT_EQ(store.x_positions()[0], 5.0f);
+}
+
+TEST(ParticleStoreTest, IntegrateMovesParticlesUpwards) {
+  ParticleStore store;
+
+  // Enough particles to exercise both the SIMD and scalar tail loops.
+  for (int i = 0; i < 11; ++i) {
+    store.spawn({.x = 0.0f, .y = static_cast<float>(i), .speed = 10.0f});
+  }
+
+  EXPECT_EQ(store.integrate(0.5f, 0.0f, 1000.0f), 0);
+  ASSERT_EQ(store.size(), 11);
+
+  for (int i = 0; i < 11; ++i) {
+    EXPECT_FLOAT_EQ(store.y_positions()[i], i + 5.0f);
+  }
+}
+
+TEST(ParticleStoreTest, IntegrateAppliesWobble) {
+  ParticleStore store;
+  store.spawn(
+      {.x = 10.0f,
+       .speed = 0.0f,
+       .wobble_amplitude = 2.0f,
+       .wobble_frequency = 1.0f,
+       .wobble_phase = 0.5f});
+
+  store.integrate(1.0f, 1.0f, 1000.0f);
+  EXPECT_NEAR(store.x_positions()[0], 10.0f + std::sin(1.5f) * 2.0f, 1e-5f);
+}
+
+TEST(ParticleStoreTest, IntegrateRemovesParticlesPastDespawnLine) {
+  ParticleStore store;
+
+  // Every other particle starts past the despawn line.
+  for (int i = 0; i < 19; ++i) {
+    store.spawn(
+        {.x = static_cast<float>(i),
+         .y = (i % 2 == 0) ? 200.0f : 0.0f,
+         .size = 10.0f,
+         .speed = 0.0f});
+  }
+
+  EXPECT_EQ(store.integrate(1.0f, 0.0f, 100.0f), 10);
+  ASSERT_EQ(store.size(), 9);
+
+  for (const auto y : store.y_positions()) {
+    EXPECT_EQ(y, 0.0f);
+  }
+
+  // The surviving particles are exactly the odd ones.
+  std::vector<float> xs{store.x_positions().begin(), store.x_positions().end()};
+  std::ranges::sort(xs);
+
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_EQ(xs[i], 2.0f * i + 1.0f);
+  }
+}
+
+TEST(ParticleStoreTest, IntegrateKeepsPreviousPositions) {
+  ParticleStore store;
+
+  for (int i = 0; i < 11; ++i) {
+    store.spawn({.x = 1.0f, .y = static_cast<float>(i), .speed = 10.0f});
+  }
+
+  // A new particle has not moved yet, so both positions match.
+  EXPECT_EQ(store.previous_y_positions()[3], 3.0f);
+
+  store.integrate(1.0f, 0.0f, 1000.0f);
+
+  for (int i = 0; i < 11; ++i) {
+    EXPECT_EQ(store.previous_x_positions()[i], 1.0f);
+    EXPECT_EQ(store.previous_y_positions()[i], static_cast<float>(i));
+    EXPECT_EQ(store.y_positions()[i], i + 10.0f);
+  }
+}
+
+TEST(ParticleStoreTest, InterpolatePositionsBlendsPreviousAndCurrent) {
+  ParticleStore store;
+
+  for (int i = 0; i < 11; ++i) {
+    store.spawn({.x = 2.0f, .y = static_cast<float>(i), .speed = 8.0f});
+  }
+
+  store.integrate(1.0f, 0.0f, 1000.0f);
+
+  std::vector<float> x(store.size());
+  std::vector<float> y(store.size());
+
+  for (const float alpha : {0.0f, 0.25f, 1.0f}) {
+    store.interpolate_positions(alpha, x, y);
+
+    for (int i = 0; i < 11; ++i) {
+      EXPECT_FLOAT_EQ(x[i], 2.0f);
+      EXPECT_FLOAT_EQ(y[i], i + 8.0f * alpha);
+    }
+  }
+}
@@ -0,0 +1,39 @@
+#include <forge/pixel_format.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(PixelFormatTest, SwapRedBlueSwapsOnlyRedAndBlue) {
+  // Use enough pixels to cover the SIMD loops and a scalar tail.
+  constexpr size_t kPixelCount = 37;
+  std::vector<unsigned char> pixels;
+
+  for (size_t i = 0; i < kPixelCount; ++i) {
+    pixels.push_back(static_cast<unsigned char>(i));       // red
+    pixels.push_back(static_cast<unsigned char>(100 + i)); // green
+    pixels.push_back(static_cast<unsigned char>(200 - i)); // blue
+    pixels.push_back(static_cast<unsigned char>(255 - i)); // alpha
+  }
+
+  const auto original = pixels;
+  swap_red_blue(pixels);
+
+  for (size_t i = 0; i < kPixelCount; ++i) {
+    EXPECT_EQ(pixels[i * 4 + 0], original[i * 4 + 2]);
+    EXPECT_EQ(pixels[i * 4 + 1], original[i * 4 + 1]);
+    EXPECT_EQ(pixels[i * 4 + 2], original[i * 4 + 0]);
+    EXPECT_EQ(pixels[i * 4 + 3], original[i * 4 + 3]);
+  }
+
+  // Swapping twice restores the original order.
+  swap_red_blue(pixels);
+  EXPECT_EQ(pixels, original);
+}
+
+TEST(PixelFormatTest, SwapRedBlueIgnoresPartialPixels) {
+  std::vector<unsigned char> pixels = {1, 2, 3, 4, 5, 6};
+  swap_red_blue(pixels);
+
+  EXPECT_EQ(pixels, (std::vector<unsigned char>{3, 2, 1, 4, 5, 6}));
+}
@@ -0,0 +1,170 @@
+#include <forge/spatial_grid.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace {
+  std::vector<uint32_t> point_candidates(
+      const SpatialGrid& grid,
+      float x,
+      float y) {
+    std::vector<uint32_t> ids;
+
+    grid.query_point(x, y, [&ids](uint32_t id) {
+      ids.push_back(id);
+      return true;
+    });
+
+    std::ranges::sort(ids);
+    return ids;
+  }
+
+  bool contains(const std::vector<uint32_t>& ids, uint32_t id) {
+    return std::ranges::find(ids, id) != ids.end();
+  }
+} // namespace
+
+TEST(SpatialGridTest, EmptyGridHasNoCandidates) {
+  SpatialGrid grid{10.0f};
+  EXPECT_TRUE(point_candidates(grid, 0.0f, 0.0f).empty());
+
+  grid.build();
+  EXPECT_TRUE(point_candidates(grid, 0.0f, 0.0f).empty());
+}
+
+TEST(SpatialGridTest, PointQueryFindsEntityCoveringPoint) {
+  SpatialGrid grid{10.0f};
+  grid.insert(7, 5.0f, 5.0f, 2.0f);
+  grid.build();
+
+  EXPECT_TRUE(contains(point_candidates(grid, 5.0f, 5.0f), 7));
+}
+
+TEST(SpatialGridTest, EntitySpanningCellsIsFoundFromEachCell) {
+  SpatialGrid grid{10.0f};
+
+  // Centered on the corner shared by four cells.
+  grid.insert(3, 10.0f, 10.0f, 4.0f);
+  grid.build();
+
+  EXPECT_TRUE(contains(point_candidates(grid, 7.0f, 7.0f), 3));
+  EXPECT_TRUE(contains(point_candidates(grid, 13.0f, 7.0f), 3));
+  EXPECT_TRUE(contains(point_candidates(grid, 7.0f, 13.0f), 3));
+  EXPECT_TRUE(contains(point_candidates(grid, 13.0f, 13.0f), 3));
+}
+
+TEST(SpatialGridTest, PointQueryOnlyVisitsNearbyEntities) {
+  SpatialGrid grid{10.0f};
+
+  for (uint32_t i = 0; i < 1000; ++i) {
+    grid.insert(i, static_cast<float>(i) * 20.0f + 5.0f, 5.0f, 1.0f);
+  }
+
+  grid.build();
+
+  // Hash collisions can add a few extra candidates, but a point query must
+  // never need to look at anything close to every entity.
+  const auto candidates = point_candidates(grid, 205.0f, 5.0f);
+  EXPECT_TRUE(contains(candidates, 10));
+  EXPECT_LT(candidates.size(), 10);
+}
+
+TEST(SpatialGridTest, CircleQueryFindsOverlappingEntities) {
+  SpatialGrid grid{10.0f};
+  grid.insert(1, 5.0f, 5.0f, 1.0f);
+  grid.insert(2, 25.0f, 5.0f, 1.0f);
+  grid.build();
+
+  std::vector<uint32_t> ids;
+  grid.query_circle(15.0f, 5.0f, 10.0f, [&ids](uint32_t id) {
+    ids.push_back(id);
+    return true;
+  });
+
+  EXPECT_TRUE(contains(ids, 1));
+  EXPECT_TRUE(contains(ids, 2));
+}
+
+TEST(SpatialGridTest, QueryStopsWhenVisitReturnsFalse) {
+  SpatialGrid grid{10.0f};
+
+  for (uint32_t i = 0; i < 5; ++i) {
+    grid.insert(i, 5.0f, 5.0f, 1.0f);
+  }
+
+  grid.build();
+
+  int visits = 0;
+  grid.query_point(5.0f, 5.0f, [&visits](uint32_t) {
+    visits++;
+    return false;
+  });
+
+  EXPECT_EQ(visits, 1);
+}
+
+TEST(SpatialGridTest, RemoveDeletesEntityFromEveryCell) {
+  SpatialGrid grid{10.0f};
+  grid.insert(3, 10.0f, 10.0f, 4.0f);
+  grid.insert(4, 10.0f, 10.0f, 4.0f);
+  grid.build();
+
+  EXPECT_TRUE(grid.remove(3, 10.0f, 10.0f, 4.0f));
+  EXPECT_FALSE(grid.remove(3, 10.0f, 10.0f, 4.0f));
+
+  EXPECT_FALSE(contains(point_candidates(grid, 7.0f, 7.0f), 3));
+  EXPECT_FALSE(contains(point_candidates(grid, 13.0f, 13.0f), 3));
+  EXPECT_TRUE(contains(point_candidates(grid, 13.0f, 13.0f), 4));
+}
+
+TEST(SpatialGridTest, ReplaceIdRenamesEntity) {
+  SpatialGrid grid{10.0f};
+  grid.insert(9, 10.0f, 10.0f, 4.0f);
+  grid.build();
+
+  EXPECT_TRUE(grid.replace_id(9, 2, 10.0f, 10.0f, 4.0f));
+
+  const auto candidates = point_candidates(grid, 13.0f, 13.0f);
+  EXPECT_TRUE(contains(candidates, 2));
+  EXPECT_FALSE(contains(candidates, 9));
+}
+
+TEST(SpatialGridTest, BuildReplacesPreviousContents) {
+  SpatialGrid grid{10.0f};
+  grid.insert(1, 5.0f, 5.0f, 1.0f);
+  grid.build();
+
+  grid.insert(2, 5.0f, 5.0f, 1.0f);
+  grid.build();
+
+  const auto candidates = point_candidates(grid, 5.0f, 5.0f);
+  EXPECT_FALSE(contains(candidates, 1));
+  EXPECT_TRUE(contains(candidates, 2));
+}
+
+TEST(SpatialGridTest, NegativeCoordinatesAreSupported) {
+  SpatialGrid grid{10.0f};
+  grid.insert(5, -15.0f, -25.0f, 2.0f);
+  grid.build();
+
+  EXPECT_TRUE(contains(point_candidates(grid, -15.0f, -25.0f), 5));
+}
+
+TEST(SpatialGridTest, OutOfRangeCoordinatesAreClamped) {
+  constexpr auto kNaN = std::numeric_limits<float>::quiet_NaN();
+  constexpr auto kInfinity = std::numeric_limits<float>::infinity();
+
+  SpatialGrid grid{10.0f};
+  grid.insert(1, 1e30f, -1e30f, 1.0f);
+  grid.insert(2, kNaN, 0.0f, 1.0f);
+  grid.insert(3, kInfinity, 0.0f, 1.0f);
+  grid.build();
+
+  // Far away entities share the edge cell, so they are still found.
+  EXPECT_TRUE(contains(point_candidates(grid, 1e30f, -1e30f), 1));
+  EXPECT_TRUE(contains(point_candidates(grid, 1e29f, 0.0f), 3));
+  EXPECT_TRUE(grid.remove(2, kNaN, 0.0f, 1.0f));
+}
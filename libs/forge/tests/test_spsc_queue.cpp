@@ -0,0 +1,92 @@
+#include <forge/spsc_queue.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+TEST(SpscQueueTest, NewQueueIsEmpty) {
+  SpscQueue<int, 8> queue;
+  int value = 0;
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.size(), 0);
+  EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(SpscQueueTest, PopsInPushOrder) {
+  SpscQueue<int, 8> queue;
+
+  EXPECT_TRUE(queue.try_push(1));
+  EXPECT_TRUE(queue.try_push(2));
+  EXPECT_TRUE(queue.try_push(3));
+  EXPECT_EQ(queue.size(), 3);
+
+  int value = 0;
+
+  EXPECT_TRUE(queue.try_pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(queue.try_pop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(queue.try_pop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(SpscQueueTest, PushFailsWhenFull) {
+  SpscQueue<int, 4> queue;
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+
+  EXPECT_FALSE(queue.try_push(4));
+
+  int value = 0;
+  EXPECT_TRUE(queue.try_pop(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(queue.try_push(4));
+}
+
+TEST(SpscQueueTest, WrapsAroundManyTimes) {
+  SpscQueue<int, 4> queue;
+  int value = 0;
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(queue.try_push(i));
+    EXPECT_TRUE(queue.try_push(i + 1000));
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, i);
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, i + 1000);
+  }
+
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, TransfersBetweenThreadsInOrder) {
+  constexpr int kCount = 200000;
+  SpscQueue<int, 64> queue;
+
+  std::thread producer([&] {
+    for (int i = 0; i < kCount; ++i) {
+      while (!queue.try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int expected = 0;
+  int value = 0;
+
+  while (expected < kCount) {
+    if (queue.try_pop(value)) {
+      ASSERT_EQ(value, expected);
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  producer.join();
+  EXPECT_TRUE(queue.empty());
+}
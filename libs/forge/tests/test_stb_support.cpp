@@ -0,0 +1,107 @@
+#include <forge/support/stb_support.h>
+
+#include <gtest/gtest.h>
+
+#include "support/counting_stream.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+  std::vector<unsigned char> make_bytes(size_t size) {
+    std::vector<unsigned char> bytes(size);
+
+    for (size_t i = 0; i < size; ++i) {
+      bytes[i] = static_cast<unsigned char>(i * 31 + i / 256);
+    }
+
+    return bytes;
+  }
+} // namespace
+
+TEST(BufferedSdlReaderTest, SmallReadsAreServedFromBlocks) {
+  const auto bytes = make_bytes(1000);
+  const std::unique_ptr<SDL_IOStream, SdlIoCloser> memory{
+      SDL_IOFromConstMem(bytes.data(), bytes.size())};
+  CountingStream counting{memory.get()};
+  BufferedSdlReader reader(counting.stream.get(), 128);
+
+  std::vector<unsigned char> result(bytes.size());
+  size_t offset = 0;
+
+  while (offset < result.size()) {
+    const auto count = reader.read(
+        result.data() + offset,
+        std::min<size_t>(7, result.size() - offset));
+    ASSERT_GT(count, 0u);
+    offset += count;
+  }
+
+  EXPECT_EQ(result, bytes);
+  EXPECT_EQ(counting.read_count, 8); // ceil(1000 / 128)
+
+  unsigned char extra = 0;
+  EXPECT_EQ(reader.read(&extra, 1), 0u);
+  EXPECT_TRUE(reader.eof());
+}
+
+TEST(BufferedSdlReaderTest, LargeReadsBypassTheBuffer) {
+  const auto bytes = make_bytes(1000);
+  const std::unique_ptr<SDL_IOStream, SdlIoCloser> memory{
+      SDL_IOFromConstMem(bytes.data(), bytes.size())};
+  CountingStream counting{memory.get()};
+  BufferedSdlReader reader(counting.stream.get(), 64);
+
+  std::vector<unsigned char> result(bytes.size());
+  ASSERT_EQ(reader.read(result.data(), 10), 10u);
+  ASSERT_EQ(reader.read(result.data() + 10, 990), 990u);
+
+  EXPECT_EQ(result, bytes);
+
+  // One block, then the rest of the request straight from the stream.
+  EXPECT_EQ(counting.read_count, 2);
+}
+
+TEST(BufferedSdlReaderTest, SkipsInsideTheBlockDoNotTouchTheStream) {
+  const auto bytes = make_bytes(1000);
+  const std::unique_ptr<SDL_IOStream, SdlIoCloser> memory{
+      SDL_IOFromConstMem(bytes.data(), bytes.size())};
+  CountingStream counting{memory.get()};
+  BufferedSdlReader reader(counting.stream.get(), 256);
+
+  unsigned char value = 0;
+  ASSERT_EQ(reader.read(&value, 1), 1u);
+
+  reader.skip(99);
+  ASSERT_EQ(reader.read(&value, 1), 1u);
+  EXPECT_EQ(value, bytes[100]);
+
+  reader.skip(-51);
+  ASSERT_EQ(reader.read(&value, 1), 1u);
+  EXPECT_EQ(value, bytes[50]);
+
+  EXPECT_EQ(counting.read_count, 1);
+  EXPECT_EQ(SDL_TellIO(counting.source), 256);
+}
+
+TEST(BufferedSdlReaderTest, SkipsPastTheBlockSeekTheStream) {
+  const auto bytes = make_bytes(1000);
+  const std::unique_ptr<SDL_IOStream, SdlIoCloser> memory{
+      SDL_IOFromConstMem(bytes.data(), bytes.size())};
+  CountingStream counting{memory.get()};
+  BufferedSdlReader reader(counting.stream.get(), 256);
+
+  unsigned char value = 0;
+  ASSERT_EQ(reader.read(&value, 1), 1u);
+
+  reader.skip(600);
+  ASSERT_EQ(reader.read(&value, 1), 1u);
+  EXPECT_EQ(value, bytes[601]);
+
+  reader.skip(398);
+  EXPECT_EQ(reader.read(&value, 1), 0u);
+  EXPECT_TRUE(reader.eof());
+}
@@ -0,0 +1,116 @@
+#include <forge/texture_atlas.h>
+
+#include <gtest/gtest.h>
+
+#include "support/test_images.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+  bool overlaps(const SDL_Rect& a, const SDL_Rect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h &&
+           b.y < a.y + a.h;
+  }
+} // namespace
+
+TEST(SkylinePackerTest, PacksInsideBoundsWithoutOverlap) {
+  SkylinePacker packer(256, 256);
+  std::default_random_engine engine(42);
+  std::uniform_int_distribution<int> size(4, 40);
+  std::vector<SDL_Rect> packed;
+
+  for (int i = 0; i < 200; ++i) {
+    const auto rect = packer.pack(size(engine), size(engine));
+
+    if (!rect) {
+      continue;
+    }
+
+    EXPECT_GE(rect->x, 0);
+    EXPECT_GE(rect->y, 0);
+    EXPECT_LE(rect->x + rect->w, 256);
+    EXPECT_LE(rect->y + rect->h, 256);
+
+    for (const auto& other : packed) {
+      EXPECT_FALSE(overlaps(*rect, other));
+    }
+
+    packed.push_back(*rect);
+  }
+
+  EXPECT_GT(packed.size(), 50);
+  EXPECT_GT(packer.occupancy(), 0.6f);
+}
+
+TEST(SkylinePackerTest, FillsExactlyAndRejectsWhenFull) {
+  SkylinePacker packer(64, 64);
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(packer.pack(32, 32).has_value());
+  }
+
+  EXPECT_FLOAT_EQ(packer.occupancy(), 1.0f);
+  EXPECT_FALSE(packer.pack(1, 1).has_value());
+  EXPECT_FALSE(packer.pack(65, 1).has_value());
+
+  packer.clear();
+  EXPECT_FLOAT_EQ(packer.occupancy(), 0.0f);
+  EXPECT_TRUE(packer.pack(64, 64).has_value());
+}
+
+TEST(SkylinePackerTest, FillsLowGapsFirst) {
+  SkylinePacker packer(100, 100);
+
+  // A tall column on the left leaves a low gap on the right for the next
+  // rectangle.
+  const auto tall = packer.pack(50, 80);
+  const auto gap = packer.pack(50, 20);
+
+  ASSERT_TRUE(tall.has_value());
+  ASSERT_TRUE(gap.has_value());
+  EXPECT_EQ(gap->x, 50);
+  EXPECT_EQ(gap->y, 0);
+}
+
+TEST(TextureAtlasTest, PadsRegionsAndReusesNames) {
+  TextureAtlas atlas(64);
+
+  const auto region = atlas.add(make_test_image(10, 12), "a");
+  ASSERT_TRUE(region.has_value());
+  EXPECT_EQ(region->page, 0);
+  EXPECT_FLOAT_EQ(region->src_rect.x, TextureAtlas::kPadding);
+  EXPECT_FLOAT_EQ(region->src_rect.y, TextureAtlas::kPadding);
+  EXPECT_FLOAT_EQ(region->src_rect.w, 10.0f);
+  EXPECT_FLOAT_EQ(region->src_rect.h, 12.0f);
+
+  const auto again = atlas.add(make_test_image(10, 12), "a");
+  ASSERT_TRUE(again.has_value());
+  EXPECT_FLOAT_EQ(again->src_rect.x, region->src_rect.x);
+  EXPECT_EQ(atlas.pending_upload_count(), 1);
+
+  ASSERT_TRUE(atlas.find("a").has_value());
+  EXPECT_FALSE(atlas.find("b").has_value());
+}
+
+TEST(TextureAtlasTest, StartsNewPagesAndRejectsOversizedImages) {
+  TextureAtlas atlas(32);
+
+  const auto first = atlas.add(make_test_image(20, 20));
+  const auto second = atlas.add(make_test_image(20, 20));
+
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first->page, 0);
+  EXPECT_EQ(second->page, 1);
+  EXPECT_EQ(atlas.page_count(), 2);
+
+  // The padding must fit on the page too.
+  EXPECT_FALSE(atlas.add(make_test_image(31, 31)).has_value());
+
+  // Smaller images still fill the space left on earlier pages.
+  const auto strip = atlas.add(make_test_image(30, 1));
+  ASSERT_TRUE(strip.has_value());
+  EXPECT_EQ(strip->page, 0);
+  EXPECT_EQ(atlas.page_count(), 2);
+}
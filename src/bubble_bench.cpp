@@ -0,0 +1,191 @@
+// Runs BubbleGame without a window, GPU or audio device and reports how fast
+// the game loop runs. The dummy video and audio drivers stand in for real
+// devices, bubbles are drawn by the software renderer and time is simulated,
+// so every run does the same work and can be compared across machines and
+// builds.
+//
+// Usage:
+//   bubble_bench [frame_count] [frames_per_second] [update_rate_hz]
+//
+// Example:
+//   bubble_bench 20000 144 60
+#include "bubble_game.h"
+
+#include <forge/game.h>
+#include <forge/support/sdl_support.h>
+
+#include <SDL3/SDL.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+constexpr Uint64 kDefaultFrameCount = 10000;
+constexpr Uint64 kDefaultFramesPerSecond = 60;
+constexpr unsigned int kRandomSeed = 1234;
+constexpr Uint64 kContentLoadTimeoutMs = 10000;
+
+// Count every heap allocation made by the process so allocations in the game
+// loop can be reported.
+static std::atomic<Uint64> GAllocationCount{0};
+static std::atomic<Uint64> GAllocatedBytes{0};
+
+void* operator new(size_t size) {
+  GAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  GAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+  if (void* p = std::malloc(size > 0 ? size : 1)) {
+    return p;
+  }
+
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, size_t /*size*/) noexcept { std::free(p); }
+
+/// Parses a positive integer argument, or returns `fallback` if the argument
+/// is missing.
+static Uint64 parse_argument(
+    int argc,
+    char* argv[],
+    int index,
+    Uint64 fallback) {
+  if (index >= argc) {
+    return fallback;
+  }
+
+  const auto value = std::strtoull(argv[index], nullptr, 10);
+  return value > 0 ? value : fallback;
+}
+
+int main(int argc, char* argv[]) {
+  const auto frame_count = parse_argument(argc, argv, 1, kDefaultFrameCount);
+  const auto frames_per_second =
+      parse_argument(argc, argv, 2, kDefaultFramesPerSecond);
+  const auto update_rate_hz =
+      parse_argument(argc, argv, 3, BubbleGame::kDefaultUpdateRate);
+
+  // Use drivers that need no display or sound hardware.
+  SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+  SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+  SDL_SetLogPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN);
+
+  if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
+    SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "SDL Error: %s", SDL_GetError());
+    return EXIT_FAILURE;
+  }
+
+  unique_sdl_window_ptr window{
+      SDL_CreateWindow("bubble_bench", 352, 430, SDL_WINDOW_HIDDEN)};
+
+  if (!window) {
+    SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "SDL Error: %s", SDL_GetError());
+    return EXIT_FAILURE;
+  }
+
+  unique_sdl_renderer_ptr renderer{
+      SDL_CreateRenderer(window.get(), "software")};
+
+  if (!renderer) {
+    SDL_LogError(
+        SDL_LOG_CATEGORY_CUSTOM,
+        "SDL_CreateRenderer error: %s",
+        SDL_GetError());
+    return EXIT_FAILURE;
+  }
+
+  auto game =
+      std::make_unique<BubbleGame>(std::move(renderer), std::move(window));
+
+  // Advance a simulated clock by exactly one frame per `iterate` call, so the
+  // number of updates run is the same no matter how fast this machine is.
+  Uint64 simulated_time_ns = 0;
+  const auto frame_time_ns = SDL_NS_PER_SECOND / frames_per_second;
+
+  game->set_clock([&simulated_time_ns] { return simulated_time_ns; });
+  game->set_random_seed(kRandomSeed);
+  game->set_update_rate(static_cast<Uint32>(update_rate_hz));
+  game->profiler().set_logging_enabled(false);
+
+  if (game->init() == SDL_APP_FAILURE) {
+    SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "Game failed to initialize");
+    return EXIT_FAILURE;
+  }
+
+  // Content loads on worker threads in real time, so keep iterating until it
+  // arrives. The simulation does not start until then.
+  const auto load_start_ms = SDL_GetTicks();
+
+  while (!game->content_loaded()) {
+    if (SDL_GetTicks() - load_start_ms > kContentLoadTimeoutMs) {
+      SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "timed out loading game content");
+      return EXIT_FAILURE;
+    }
+
+    simulated_time_ns += frame_time_ns;
+
+    if (game->iterate() == SDL_APP_FAILURE) {
+      return EXIT_FAILURE;
+    }
+
+    SDL_Delay(1);
+  }
+
+  // Run the game loop.
+  const auto stats_before = game->loop_stats();
+  const auto allocations_before = GAllocationCount.load();
+  const auto allocated_bytes_before = GAllocatedBytes.load();
+  const auto wall_start = std::chrono::steady_clock::now();
+
+  for (Uint64 frame = 0; frame < frame_count; ++frame) {
+    simulated_time_ns += frame_time_ns;
+
+    if (game->iterate() == SDL_APP_FAILURE) {
+      SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "Game iteration failed");
+      return EXIT_FAILURE;
+    }
+  }
+
+  const std::chrono::duration<double> wall_time =
+      std::chrono::steady_clock::now() - wall_start;
+  const auto& stats = game->loop_stats();
+  const auto updates = stats.updates - stats_before.updates;
+  const auto renders = stats.frames - stats_before.frames;
+  const auto allocations = GAllocationCount.load() - allocations_before;
+  const auto allocated_bytes = GAllocatedBytes.load() - allocated_bytes_before;
+
+  std::printf(
+      "frames:            %llu (%llu fps simulated, %llu Hz updates)\n"
+      "wall time:         %.3f s\n"
+      "updates/sec:       %.1f\n"
+      "renders/sec:       %.1f\n"
+      "allocations:       %llu (%.2f per frame)\n"
+      "allocated bytes:   %llu (%.1f per frame)\n"
+      "dropped updates:   %llu\n"
+      "clamped time:      %.3f s\n",
+      static_cast<unsigned long long>(frame_count),
+      static_cast<unsigned long long>(frames_per_second),
+      static_cast<unsigned long long>(update_rate_hz),
+      wall_time.count(),
+      updates / wall_time.count(),
+      renders / wall_time.count(),
+      static_cast<unsigned long long>(allocations),
+      static_cast<double>(allocations) / frame_count,
+      static_cast<unsigned long long>(allocated_bytes),
+      static_cast<double>(allocated_bytes) / frame_count,
+      static_cast<unsigned long long>(
+          stats.dropped_updates - stats_before.dropped_updates),
+      static_cast<double>(
+          stats.clamped_time_ns - stats_before.clamped_time_ns) /
+          SDL_NS_PER_SECOND);
+
+  game.reset();
+  SDL_Quit();
+
+  return EXIT_SUCCESS;
+}
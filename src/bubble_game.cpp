@@ -2,16 +2,25 @@
 
 #include "bubble_game.h"
 
+#include <forge/async_content_loader.h>
 #include <forge/audio_manager.h>
 #include <forge/content.h>
+#include <forge/job_system.h>
+#include <forge/log.h>
+#include <forge/texture_atlas.h>
 #include <forge/support/sdl_support.h>
 
 #include <SDL3/SDL.h>
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <functional>
+#include <memory_resource>
+#include <optional>
 #include <random>
+#include <vector>
 
 // TODO: Spawn bubbles in waves
 // TODO: Spawn random counts of bubbles.
@@ -19,11 +28,7 @@
 // TODO: Scale bubbles to size of window.
 // TODO: Draw a gradient water background.
 // TODO: Display the number of bubbles popped.
-// TODO: Draw debug stats every N seconds (1 sec screen, 5 console)
-//        - time per update() (average, min, max)
-//        - time per render()
-//        - number of update, render calls / second
-//        - memory use
+// TODO: Draw `FrameProfiler` stats on screen every second, and memory use.
 
 bool GDebugRenderEntity = false;
 bool GDebugRenderClick = false;
@@ -31,7 +36,7 @@ bool GDebugRenderClick = false;
 constexpr int BUBBLE_COUNT_MAX = 64;
 constexpr int BUBBLE_COUNT_MIN = 64;
 
-constexpr float BUBBLE_PIXEL_WIDTH_AND_HEIGHT = 512.f;
+constexpr float BUBBLE_DEFAULT_SIZE = 64.f;
 constexpr float BUBBLE_MIN_FLOAT_SPEED = 90.f;
 constexpr float BUBBLE_MAX_FLOAT_SPEED = 150.f;
 constexpr float BUBBLE_MIN_X = 0.f;
@@ -43,46 +48,67 @@ constexpr float BUBBLE_MAX_WOBBLE_PERIOD = 2.0f;
 constexpr float BUBBLE_MIN_WOBBLE_OFFSET = 0.0f;
 constexpr float BUBBLE_MAX_WOBBLE_OFFSET = M_2_PI;
 constexpr float BUBBLE_CLICK_FUZZ = 0.9;
+constexpr float BUBBLE_GRID_CELL_SIZE = 128.f; // largest bubble size.
 
 constexpr std::array<float, 4> BUBBLE_SIZES = {48.0f, 64.0f, 72.0f, 128.0f};
 
+// Smallest mip level generated for the bubble image, which only needs to cover
+// the smallest bubble size.
+constexpr int BUBBLE_MIN_MIP_SIZE = 48;
+
 BubbleGame::BubbleGame(
     unique_sdl_renderer_ptr renderer,
     unique_sdl_window_ptr window)
     : Game(
           std::move(renderer),
           std::move(window)),
-      random_engine_(random_device_()) {}
+      random_engine_(random_device_()),
+      bubble_grid_(BUBBLE_GRID_CELL_SIZE) {}
 
 SDL_AppResult BubbleGame::on_init() {
-  // Load game content.
-  bubble_texture_ = load_texture(renderer_.get(), "content/bubble.png");
+  // Start loading game content in the background. The game waits on the
+  // loading screen until everything has arrived.
+  bubble_mips_future_ = content_loader_->load_mip_chain(
+      "content/bubble.png",
+      BUBBLE_MIN_MIP_SIZE);
+  pop_audio_buffer_future_ = content_loader_->load_ogg("content/pop.ogg");
+
+  // Reserve storage for the maximum number of bubbles up front.
+  bubbles_.reserve(BUBBLE_COUNT_MAX);
 
-  if (bubble_texture_ == nullptr) {
-    SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "failed to load bubble image");
-    return SDL_APP_FAILURE;
-  }
+  return SDL_APP_CONTINUE;
+}
 
-  pop_audio_buffer_ = load_ogg("content/pop.ogg");
+SDL_AppResult BubbleGame::on_input(
+    float /*delta_s*/,
+    std::span<const PointerEvent> pointer_events) {
+  // Only mouse clicks pop bubbles. SDL also reports touches as mouse clicks,
+  // so handling both would pop twice per tap.
+  auto clicks = std::pmr::vector<PointerEvent>(frame_memory());
 
-  if (pop_audio_buffer_ == nullptr) {
-    SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "failed to load pop_audio_buffer");
-    return SDL_APP_FAILURE;
+  for (const auto& pointer : pointer_events) {
+    if (pointer.type == PointerEventType::MouseClick) {
+      clicks.push_back(pointer);
+    }
   }
 
-  // Instantiate the pool of bubbles.
-  bubbles_.reserve(BUBBLE_COUNT_MAX);
-
-  for (size_t i = 0; i < BUBBLE_COUNT_MAX; ++i) {
-    bubbles_.push_back(Bubble{});
+  if (!clicks.empty()) {
+    pop_bubbles_at(clicks);
   }
 
   return SDL_APP_CONTINUE;
 }
 
-SDL_AppResult BubbleGame::on_input(float delta_s) { return SDL_APP_SUCCESS; }
-
 SDL_AppResult BubbleGame::on_update(float delta_s) {
+  // Wait for game content to finish loading before starting the simulation.
+  if (receive_content() == SDL_APP_FAILURE) {
+    return SDL_APP_FAILURE;
+  }
+
+  if (!content_loaded()) {
+    return SDL_APP_CONTINUE;
+  }
+
   elapsed_time_s_ += delta_s;
 
   // Randomizers for bubble properties when spawning.
@@ -103,52 +129,39 @@ SDL_AppResult BubbleGame::on_update(float delta_s) {
 
   // Spawn bubbles when there are too few bubbles on the screen.
   const auto population = bubble_count();
-  auto spawn_count = bubbles_.size() - population;
-
-  for (auto& bubble : bubbles_) {
-    // Stop searching for new spawn slots when the spawner has hit its target.
-    if (spawn_count == 0) {
-      break;
-    }
-
-    // Check if this bubble slot is dead, and if so then spawn a new bubble in.
-    if (!bubble.alive) {
-      bubble.alive = true;
-      bubble.x = std::clamp(
-          start_x_distribution(random_engine_),
-          bubble.size / 2,
-          pixel_width() - bubble.size / 2);
-      bubble.y = -bubble.size;
-      bubble.radius = bubble.size / 2.f * BUBBLE_CLICK_FUZZ;
-      bubble.speed = speed_distribution(random_engine_);
-      bubble.wobble_x = wobble_x_distribution(random_engine_);
-      bubble.wobble_period = wobble_p_distribution(random_engine_);
-      bubble.wobble_offset = wobble_offset_distribution(random_engine_);
-
-      spawn_count--;
-    }
+  const auto half_size = BUBBLE_DEFAULT_SIZE / 2;
+
+  for (auto i = population; i < static_cast<size_t>(BUBBLE_COUNT_MAX); ++i) {
+    bubbles_.spawn(ParticleDesc{
+        .x = std::clamp(
+            start_x_distribution(random_engine_),
+            half_size,
+            pixel_width() - half_size),
+        .y = -BUBBLE_DEFAULT_SIZE,
+        .size = BUBBLE_DEFAULT_SIZE,
+        .speed = speed_distribution(random_engine_),
+        .wobble_amplitude = wobble_x_distribution(random_engine_),
+        .wobble_frequency = wobble_p_distribution(random_engine_),
+        .wobble_phase = wobble_offset_distribution(random_engine_),
+    });
   }
 
-  // Make the bubbles float upwards.
-  for (auto& bubble : bubbles_) {
-    if (!bubble.alive) {
-      continue;
-    }
+  // Make the bubbles float upwards, and despawn bubbles when they float past
+  // the top.
+  bubbles_.integrate(delta_s, elapsed_time_s_, pixel_height(), *jobs_);
 
-    bubble.y += bubble.speed * delta_s;
-    bubble.x +=
-        sin(bubble.wobble_offset + elapsed_time_s_ * bubble.wobble_period) *
-        bubble.wobble_x;
+  // Rebuild the spatial index of bubbles so clicks and touches can be hit
+  // tested without checking every bubble.
+  const auto bubble_x = bubbles_.x_positions();
+  const auto bubble_y = bubbles_.y_positions();
+  const auto bubble_size = bubbles_.sizes();
 
-    // sin(_controller.value * 2 * pi + bubble.y * 10) * 0.005
+  for (size_t i = 0; i < bubbles_.size(); ++i) {
+    bubble_grid_.insert(
+        static_cast<uint32_t>(i), bubble_x[i], bubble_y[i], bubble_size[i] / 2);
   }
 
-  // Despawn bubbles when they float past the top.
-  for (auto& bubble : bubbles_) {
-    if (bubble.y >= pixel_height() + bubble.size) {
-      bubble.alive = false;
-    }
-  }
+  bubble_grid_.build();
 
   return SDL_APP_CONTINUE;
 }
@@ -158,12 +171,37 @@ SDL_AppResult BubbleGame::on_render(float delta_s, float extrapolation) {
   SDL_SetRenderDrawColor(renderer_.get(), 25, 150, 255, SDL_ALPHA_OPAQUE);
   SDL_RenderClear(renderer_.get());
 
+  // Only show the background while game content is loading.
+  if (!content_loaded()) {
+    SDL_RenderPresent(renderer_.get());
+    return SDL_APP_CONTINUE;
+  }
+
   SDL_SetRenderDrawColor(renderer_.get(), 255, 0, 255, SDL_ALPHA_OPAQUE);
 
-  // Draw bubbles on the screen.
-  for (const auto& bubble : bubbles_) {
-    if (draw_bubble(bubble.x, bubble.y, bubble.size) == SDL_APP_FAILURE) {
-      return SDL_APP_FAILURE;
+  // Draw bubbles between their last two simulated positions so they move
+  // smoothly even when the display refreshes faster than the simulation.
+  render_x_.resize(bubbles_.size());
+  render_y_.resize(bubbles_.size());
+  bubbles_.interpolate_positions(extrapolation, render_x_, render_y_);
+
+  // Draw bubbles on the screen. Bubbles are queued into a sprite batch and then
+  // submitted together in a single draw call.
+  const auto& bubble_x = render_x_;
+  const auto& bubble_y = render_y_;
+  const auto bubble_size = bubbles_.sizes();
+
+  for (size_t i = 0; i < bubbles_.size(); ++i) {
+    draw_bubble(bubble_x[i], bubble_y[i], bubble_size[i]);
+  }
+
+  if (!sprite_batch_.flush(renderer_.get())) {
+    return SDL_APP_FAILURE;
+  }
+
+  if (GDebugRenderEntity) {
+    for (size_t i = 0; i < bubbles_.size(); ++i) {
+      draw_bubble_debug(bubble_x[i], bubble_y[i], bubble_size[i]);
     }
   }
 
@@ -183,87 +221,189 @@ SDL_AppResult BubbleGame::on_render(float delta_s, float extrapolation) {
   return SDL_APP_SUCCESS;
 }
 
-SDL_AppResult BubbleGame::draw_bubble(float x, float y, float size) const {
-  SDL_assert(bubble_texture_.get() != nullptr);
-  const auto half_size = size / 2.f;
+SDL_AppResult BubbleGame::receive_content() {
+  const auto is_ready = [](const auto& future) {
+    using namespace std::chrono_literals;
+    return future.valid() &&
+           future.wait_for(0s) == std::future_status::ready;
+  };
 
-  const auto top = y + half_size;
-  const auto left = x - half_size;
+  if (is_ready(bubble_mips_future_)) {
+    // Pack every mip level of the bubble into the texture atlas, and upload
+    // them straight away so they can be drawn this frame.
+    const auto bubble_mips = bubble_mips_future_.get();
 
-  SDL_FRect src_rect{
-      0, 0, BUBBLE_PIXEL_WIDTH_AND_HEIGHT, BUBBLE_PIXEL_WIDTH_AND_HEIGHT};
-  SDL_FRect dest_rect{left, pixel_height() - top, size, size};
+    for (size_t i = 0; i < bubble_mips.level_count(); ++i) {
+      const auto region = texture_atlas_->add(bubble_mips.level(i));
 
-  if (!SDL_RenderTexture(
-          renderer_.get(), bubble_texture_.get(), &src_rect, &dest_rect)) {
-    SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "SDL Error: %s", SDL_GetError());
-    return SDL_APP_FAILURE;
+      if (!region) {
+        break;
+      }
+
+      bubble_sprites_.push_back(*region);
+    }
+
+    if (bubble_sprites_.empty() ||
+        bubble_sprites_.size() != bubble_mips.level_count() ||
+        !texture_atlas_->upload(renderer_.get())) {
+      SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "failed to load bubble image");
+      return SDL_APP_FAILURE;
+    }
   }
 
-  // Debug helpers:
-  if (GDebugRenderEntity) {
-    //  Show the rendered rectangle.
-    SDL_SetRenderDrawColor(renderer_.get(), 255, 0, 255, SDL_ALPHA_OPAQUE);
-    SDL_RenderRect(renderer_.get(), &dest_rect);
+  if (is_ready(pop_audio_buffer_future_)) {
+    pop_audio_buffer_ = pop_audio_buffer_future_.get();
 
-    // Show the sprite center.
-    SDL_SetRenderDrawColor(renderer_.get(), 255, 255, 255, 255);
-    SDL_RenderPoint(renderer_.get(), x, pixel_height() - y);
+    if (pop_audio_buffer_ == nullptr) {
+      SDL_LogError(SDL_LOG_CATEGORY_CUSTOM, "failed to load pop_audio_buffer");
+      return SDL_APP_FAILURE;
+    }
   }
 
   return SDL_APP_CONTINUE;
 }
 
-SDL_AppResult BubbleGame::on_mouse_click(int mouse_x, int mouse_y) {
-  pop_bubble_at(mouse_x, pixel_height() - mouse_y);
-  return SDL_APP_CONTINUE;
+bool BubbleGame::content_loaded() const {
+  return !bubble_sprites_.empty() && pop_audio_buffer_ != nullptr;
+}
+
+void BubbleGame::draw_bubble(float x, float y, float size) {
+  SDL_assert(!bubble_sprites_.empty());
+  const auto half_size = size / 2.f;
+
+  const auto top = y + half_size;
+  const auto left = x - half_size;
+
+  const SDL_FRect dest_rect{left, pixel_height() - top, size, size};
+
+  // Draw from the smallest mip level that still covers the bubble, so the
+  // renderer never samples far more pixels than it draws.
+  const auto& base = bubble_sprites_.front().src_rect;
+  const auto& sprite = bubble_sprites_[mip_level_for(
+      static_cast<int>(base.w),
+      static_cast<int>(base.h),
+      bubble_sprites_.size(),
+      size,
+      size)];
+
+  sprite_batch_.draw(
+      texture_atlas_->page_texture(sprite.page),
+      sprite.src_rect,
+      dest_rect);
+}
+
+void BubbleGame::draw_bubble_debug(float x, float y, float size) const {
+  const auto half_size = size / 2.f;
+
+  const auto top = y + half_size;
+  const auto left = x - half_size;
+
+  const SDL_FRect dest_rect{left, pixel_height() - top, size, size};
+
+  //  Show the rendered rectangle.
+  SDL_SetRenderDrawColor(renderer_.get(), 255, 0, 255, SDL_ALPHA_OPAQUE);
+  SDL_RenderRect(renderer_.get(), &dest_rect);
+
+  // Show the sprite center.
+  SDL_SetRenderDrawColor(renderer_.get(), 255, 255, 255, 255);
+  SDL_RenderPoint(renderer_.get(), x, pixel_height() - y);
 }
 
-bool BubbleGame::pop_bubble_at(float x, float y) {
-  // Check if any bubbles intersect the pop point. Pop the first bubble that
-  // natches.
-  for (auto& bubble : bubbles_) {
-    const auto delta_x = x - bubble.x;
-    const auto delta_y = y - bubble.y;
-    const auto distance_squared = delta_x * delta_x + delta_y * delta_y;
-
-    if (distance_squared < bubble.radius * bubble.radius) {
-      SDL_Log(
-          "pop bubble (%f, %f, %f) at (%f, %f) with dist = %f",
-          bubble.x,
-          bubble.y,
-          bubble.radius,
-          x,
-          y,
-          distance_squared);
-      bubble.alive = false;
-
-      if (GDebugRenderClick) {
-        debug_draw_time_left_s = 10.0f;
-        debug_mx_ = x;
-        debug_my_ = pixel_height() - y;
-        debug_bx_ = bubble.x;
-        debug_by_ = pixel_height() - bubble.y;
+size_t BubbleGame::pop_bubbles_at(std::span<const PointerEvent> clicks) {
+  // Hit test every click against the spatial grid before removing anything,
+  // because removing a bubble renumbers the last bubble and would invalidate
+  // the indices found for later clicks.
+  const auto bubble_x = bubbles_.x_positions();
+  const auto bubble_y = bubbles_.y_positions();
+  const auto bubble_size = bubbles_.sizes();
+
+  auto hits = std::pmr::vector<size_t>(frame_memory());
+  hits.reserve(clicks.size());
+
+  for (const auto& click : clicks) {
+    // Flip the click into the simulation's bottom up coordinates.
+    const auto x = static_cast<float>(click.x);
+    const auto y = static_cast<float>(pixel_height() - click.y);
+
+    std::optional<size_t> hit_index;
+
+    // Pop the first bubble that contains the click, skipping bubbles already
+    // popped by an earlier click this frame.
+    bubble_grid_.query_point(x, y, [&](uint32_t i) {
+      const auto delta_x = x - bubble_x[i];
+      const auto delta_y = y - bubble_y[i];
+      const auto distance_squared = delta_x * delta_x + delta_y * delta_y;
+      const auto radius = bubble_size[i] / 2.f * BUBBLE_CLICK_FUZZ;
+
+      if (distance_squared < radius * radius &&
+          std::find(hits.begin(), hits.end(), i) == hits.end()) {
+        FORGE_LOG_DEBUG(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "pop bubble (%f, %f, %f) at (%f, %f) with dist = %f",
+            bubble_x[i],
+            bubble_y[i],
+            radius,
+            x,
+            y,
+            distance_squared);
+
+        hit_index = i;
+        return false;
       }
 
-      audio_->play_once(pop_audio_buffer_.get()); // NOLINT
       return true;
+    });
+
+    if (GDebugRenderClick) {
+      debug_draw_time_left_s = 10.0f;
+      debug_mx_ = x;
+      debug_my_ = pixel_height() - y;
+      debug_bx_ = hit_index ? bubble_x[*hit_index] : x;
+      debug_by_ = pixel_height() - (hit_index ? bubble_y[*hit_index] : y);
+    }
+
+    if (hit_index) {
+      hits.push_back(*hit_index);
     }
   }
 
-  // No hit
-  if (GDebugRenderClick) {
-    debug_draw_time_left_s = 10.0f;
-    debug_mx_ = x;
-    debug_my_ = pixel_height() - y;
-    debug_bx_ = x;
-    debug_by_ = pixel_height() - y;
+  // Remove from the highest index down, so each removal only moves a bubble
+  // that has already been handled or was not hit.
+  std::sort(hits.begin(), hits.end(), std::greater<>());
+
+  for (const auto index : hits) {
+    remove_bubble(index);
+    audio_->play_once(pop_audio_buffer_.get()); // NOLINT
+  }
+
+  return hits.size();
+}
+
+void BubbleGame::remove_bubble(size_t index) {
+  const auto bubble_x = bubbles_.x_positions();
+  const auto bubble_y = bubbles_.y_positions();
+  const auto bubble_size = bubbles_.sizes();
+
+  // Removing a bubble moves the last bubble into its slot, so patch the spatial
+  // grid to match rather than rebuilding it.
+  const auto last = bubbles_.size() - 1;
+
+  bubble_grid_.remove(
+      static_cast<uint32_t>(index),
+      bubble_x[index],
+      bubble_y[index],
+      bubble_size[index] / 2);
+
+  if (index != last) {
+    bubble_grid_.replace_id(
+        static_cast<uint32_t>(last),
+        static_cast<uint32_t>(index),
+        bubble_x[last],
+        bubble_y[last],
+        bubble_size[last] / 2);
   }
 
-  return false;
+  bubbles_.swap_remove(index);
 }
 
-size_t BubbleGame::bubble_count() const {
-  return std::ranges::count_if(
-      bubbles_, [](const auto& bubble) { return bubble.alive; });
-}
\ No newline at end of file
+size_t BubbleGame::bubble_count() const { return bubbles_.size(); }
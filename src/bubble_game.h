@@ -2,10 +2,17 @@
 
 #include <forge/content.h>
 #include <forge/game.h>
+#include <forge/mip_chain.h>
+#include <forge/particle_store.h>
+#include <forge/spatial_grid.h>
+#include <forge/sprite_batch.h>
+#include <forge/texture_atlas.h>
 
 #include <SDL3/SDL.h>
 
+#include <future>
 #include <random>
+#include <span>
 #include <vector>
 
 class BubbleGame : public Game {
@@ -14,39 +21,49 @@ public:
       unique_sdl_renderer_ptr renderer,
       unique_sdl_window_ptr window);
 
+  /// Check if the game's content has finished loading.
+  bool content_loaded() const;
+
+  /// Reseed the random number generator used to spawn bubbles, so that runs
+  /// are repeatable.
+  void set_random_seed(unsigned int seed) { random_engine_.seed(seed); }
+
 protected:
   SDL_AppResult on_init() override;
-  SDL_AppResult on_input(float delta_s) override;
+  SDL_AppResult on_input(
+      float delta_s,
+      std::span<const PointerEvent> pointer_events) override;
   SDL_AppResult on_update(float delta_s) override;
   SDL_AppResult on_render(float delta_s, float extrapolation) override;
-  SDL_AppResult on_mouse_click(int mouse_x, int mouse_y) override;
 
 private:
-  SDL_AppResult draw_bubble(float x, float y, float size) const;
-  bool pop_bubble_at(float x, float y);
+  SDL_AppResult receive_content();
+  void draw_bubble(float x, float y, float size);
+  void draw_bubble_debug(float x, float y, float size) const;
+  size_t pop_bubbles_at(std::span<const PointerEvent> clicks);
+  void remove_bubble(size_t index);
   size_t bubble_count() const;
 
 private:
   std::random_device random_device_;
   std::default_random_engine random_engine_;
 
-  struct Bubble {
-    float x = 0.0;
-    float y = 0.0;
-    float size = 64.0;
-    float radius = 0.0;
-    float speed = 100.0;
-    float wobble_x = 0.0f; // amplitude
-    float wobble_period = 1.0f;
-    float wobble_offset = 0.0f;
-    bool alive = false;
-  };
-
-  std::vector<Bubble> bubbles_;
-  unique_sdl_texture_ptr bubble_texture_;
+  ParticleStore bubbles_;
+
+  /// Bubble positions blended for the current frame, reused every render.
+  std::vector<float> render_x_;
+  std::vector<float> render_y_;
+
+  SpatialGrid bubble_grid_;
+  /// Atlas regions for each mip level of the bubble image, largest first.
+  std::vector<AtlasRegion> bubble_sprites_;
+  SpriteBatch sprite_batch_;
   float elapsed_time_s_ = 0.0f;
 
-  std::unique_ptr<SdlAudioBuffer> pop_audio_buffer_;
+  std::shared_ptr<const SdlAudioBuffer> pop_audio_buffer_;
+
+  std::future<MipChain> bubble_mips_future_;
+  std::future<std::shared_ptr<const SdlAudioBuffer>> pop_audio_buffer_future_;
 
   // TODO: move to a debug helper.
   float debug_draw_time_left_s = 0.0f;
@@ -0,0 +1,216 @@
+// Packs game content files into a single archive that forge can memory map at
+// run time. See `forge/content_archive_format.h` for the archive layout.
+//
+// Usage:
+//   content_packer <output_file> <base_dir> <file_or_dir>...
+//
+// Every input file is stored under its path relative to `base_dir`, which must
+// match the path the game passes to the content loading functions. Input
+// directories are added recursively.
+//
+// Example:
+//   content_packer build/content.fpak . content
+#include <forge/content_archive_format.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct InputFile {
+  std::string path;
+  fs::path source;
+};
+
+/// Adds a file, or every file in a directory, to the list of files to pack.
+bool add_input(
+    const fs::path& base_dir,
+    const fs::path& input,
+    std::vector<InputFile>& files) {
+  const auto source = input.is_absolute() ? input : base_dir / input;
+  std::error_code error;
+
+  auto add_file = [&](const fs::path& file) {
+    files.push_back(InputFile{
+        .path = file.lexically_relative(base_dir)
+                    .lexically_normal()
+                    .generic_string(),
+        .source = file,
+    });
+  };
+
+  if (fs::is_regular_file(source, error)) {
+    add_file(source);
+    return true;
+  }
+
+  if (!fs::is_directory(source, error)) {
+    std::fprintf(
+        stderr,
+        "input %s is not a file or directory\n",
+        source.string().c_str());
+    return false;
+  }
+
+  for (const auto& entry : fs::recursive_directory_iterator(source, error)) {
+    if (entry.is_regular_file()) {
+      add_file(entry.path());
+    }
+  }
+
+  if (error) {
+    std::fprintf(
+        stderr,
+        "failed to list directory %s: %s\n",
+        source.string().c_str(),
+        error.message().c_str());
+    return false;
+  }
+
+  return true;
+}
+
+/// Reads an entire file into memory.
+bool read_file(const fs::path& path, std::vector<char>& bytes) {
+  std::ifstream file{path, std::ios::binary};
+
+  if (!file) {
+    std::fprintf(stderr, "failed to open %s\n", path.string().c_str());
+    return false;
+  }
+
+  bytes.assign(
+      std::istreambuf_iterator<char>{file},
+      std::istreambuf_iterator<char>{});
+
+  if (file.bad()) {
+    std::fprintf(stderr, "failed to read %s\n", path.string().c_str());
+    return false;
+  }
+
+  return true;
+}
+
+/// Returns `value` rounded up to the next multiple of the archive alignment.
+uint64_t align_up(uint64_t value) {
+  constexpr auto kMask = kContentArchiveAlignment - 1;
+  return (value + kMask) & ~kMask;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    std::fprintf(
+        stderr,
+        "usage: %s <output_file> <base_dir> <file_or_dir>...\n",
+        argv[0]);
+    return 1;
+  }
+
+  const fs::path output_path{argv[1]};
+  const fs::path base_dir{argv[2]};
+
+  // Gather the files to pack, sorted by path so the reader can binary search
+  // the entry table.
+  std::vector<InputFile> files;
+
+  for (int i = 3; i < argc; ++i) {
+    if (!add_input(base_dir, argv[i], files)) {
+      return 1;
+    }
+  }
+
+  std::ranges::sort(files, {}, &InputFile::path);
+
+  for (size_t i = 1; i < files.size(); ++i) {
+    if (files[i - 1].path == files[i].path) {
+      std::fprintf(stderr, "duplicate input %s\n", files[i].path.c_str());
+      return 1;
+    }
+  }
+
+  // Build the path table and entry table. File offsets are assigned while
+  // writing, once the size of each file is known.
+  std::string path_table;
+  std::vector<ContentArchiveEntry> entries(files.size());
+
+  for (size_t i = 0; i < files.size(); ++i) {
+    entries[i].path_offset = static_cast<uint32_t>(path_table.size());
+    entries[i].path_length = static_cast<uint32_t>(files[i].path.size());
+    path_table += files[i].path;
+
+    if (path_table.size() > std::numeric_limits<uint32_t>::max()) {
+      std::fprintf(stderr, "too many files to pack\n");
+      return 1;
+    }
+  }
+
+  ContentArchiveHeader header;
+  std::copy(
+      std::begin(kContentArchiveMagic),
+      std::end(kContentArchiveMagic),
+      header.magic);
+  header.version = kContentArchiveVersion;
+  header.entry_count = static_cast<uint32_t>(entries.size());
+  header.path_table_size = static_cast<uint32_t>(path_table.size());
+
+  // Write the file contents first, leaving room for the tables at the start
+  // of the archive, then go back and write the tables.
+  std::ofstream output{output_path, std::ios::binary | std::ios::trunc};
+
+  if (!output) {
+    std::fprintf(
+        stderr,
+        "failed to create %s\n",
+        output_path.string().c_str());
+    return 1;
+  }
+
+  uint64_t offset = align_up(
+      sizeof(header) + entries.size() * sizeof(ContentArchiveEntry) +
+      path_table.size());
+  std::vector<char> bytes;
+
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (!read_file(files[i].source, bytes)) {
+      return 1;
+    }
+
+    entries[i].offset = offset;
+    entries[i].size = bytes.size();
+
+    output.seekp(static_cast<std::streamoff>(offset));
+    output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+    offset = align_up(offset + bytes.size());
+  }
+
+  output.seekp(0);
+  output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  output.write(
+      reinterpret_cast<const char*>(entries.data()),
+      static_cast<std::streamsize>(entries.size() * sizeof(entries[0])));
+  output.write(
+      path_table.data(),
+      static_cast<std::streamsize>(path_table.size()));
+
+  if (!output) {
+    std::fprintf(
+        stderr,
+        "failed to write %s\n",
+        output_path.string().c_str());
+    return 1;
+  }
+
+  std::printf(
+      "packed %d files into %s\n",
+      static_cast<int>(files.size()),
+      output_path.string().c_str());
+
+  return 0;
+}